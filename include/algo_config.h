@@ -1,5 +1,7 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <vector>
 
 enum class AlgoFamily {
     ML_DSA,
@@ -12,5 +14,27 @@ struct AlgoConfig {
     std::string variant;  // "44", "65", "87", "512", "1024", etc.
 };
 
+// On-chain tag for a (family, variant) pair. Every transaction carries one,
+// so a single chain can hold accounts of different schemes.
+// Values are part of the signed/hashed encoding: never renumber them.
+enum class SchemeId : uint8_t {
+    NONE        = 0,
+    ML_DSA_44   = 1,
+    ML_DSA_65   = 2,
+    ML_DSA_87   = 3,
+    FALCON_512  = 4,
+    FALCON_1024 = 5,
+    HAWK_512    = 6,
+    HAWK_1024   = 7
+};
+
+constexpr size_t SCHEME_ID_COUNT = 8; // including NONE
+
+SchemeId schemeIdFor(const AlgoConfig& cfg);
+AlgoConfig algoConfigFor(SchemeId id);
+
+// All seven supported variants, in SchemeId order.
+std::vector<AlgoConfig> allAlgorithms();
+
 // For now, just hardcode here; later you can use CLI args.
 AlgoConfig getSelectedAlgorithm();
@@ -1,7 +1,9 @@
 #pragma once
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
+#include "byte_codec.h"
 #include "transaction.h"
 
 struct Block {
@@ -9,15 +11,114 @@ struct Block {
     std::array<uint8_t, 32> prev_hash{};  // hash of previous block
     uint64_t timestamp = 0;
     std::vector<Transaction> transactions;
+    std::array<uint8_t, 32> witness_root{}; // commitment to all tx signatures
     std::array<uint8_t, 32> block_hash{}; // hash of this block's contents
+
+    // True once the signatures (witness data) have been dropped.
+    // block_hash stays verifiable; signatures can no longer be checked.
+    bool witness_pruned = false;
 };
 
-// Serialize the parts of the block that go into block_hash computation.
-// This includes transactions and their signatures, but NOT block_hash itself.
+// The fixed-size part of a block. block_hash covers every other field;
+// body_root commits to the tx bodies and witness_root to the signatures,
+// so a chain of headers can be checked without any transaction data.
+struct BlockHeader {
+    uint32_t index = 0;
+    std::array<uint8_t, 32> prev_hash{};
+    uint64_t timestamp = 0;
+    std::array<uint8_t, 32> body_root{};
+    std::array<uint8_t, 32> witness_root{};
+    std::array<uint8_t, 32> block_hash{};
+};
+
+constexpr size_t BLOCK_HEADER_SIZE = 4 + 32 + 8 + 32 + 32 + 32; // encoded
+
+// A block's transactions, kept apart from its header.
+struct BlockBody {
+    std::vector<Transaction> transactions;
+    bool witness_pruned = false;
+};
+
+struct BlockHashHasher {
+    size_t operator()(const std::array<uint8_t, 32>& h) const {
+        size_t v = 0;
+        for (size_t i = 0; i < sizeof(size_t); ++i) {
+            v = (v << 8) | h[i]; // SHA3 output: any 8 bytes are uniform
+        }
+        return v;
+    }
+};
+
+// SHA3-256 of the tx bodies section (count + length-prefixed bodies).
+// Signatures are not included; they are committed through witness_root.
+std::array<uint8_t, 32> computeBodyRoot(const std::vector<Transaction>& txs);
+
+// The header fields block_hash is computed over: index, prev_hash,
+// timestamp, body_root and witness_root (108 bytes).
 std::vector<uint8_t> serializeBlockForHash(const Block& block);
 
-// Compute the block hash using our simpleHash32().
+// SHA3-256 of the header fields; recomputes body_root from the txs.
 std::array<uint8_t, 32> computeBlockHash(const Block& block);
+std::array<uint8_t, 32> computeHeaderHash(const BlockHeader& header);
+
+// Header of 'block' (computes body_root), and the reverse: a Block from a
+// header and the body it commits to. assembleBlock does not check the
+// commitment; use bodyMatchesHeader for that.
+BlockHeader blockHeaderOf(const Block& block);
+Block assembleBlock(const BlockHeader& header, BlockBody body);
 
-// Serialize the full block (including block_hash) to measure its size.
+// body_root matches, and witness_root too unless the body was pruned.
+bool bodyMatchesHeader(const BlockHeader& header, const BlockBody& body);
+
+// Fixed BLOCK_HEADER_SIZE encoding. deserializeBlockHeader throws
+// std::runtime_error unless given exactly that many bytes.
+std::vector<uint8_t> serializeBlockHeader(const BlockHeader& header);
+BlockHeader deserializeBlockHeader(const uint8_t* data, size_t size);
+
+// Witness section: tx count + (length + bytes) of every signature, in order.
+std::vector<uint8_t> serializeBlockWitness(const Block& block);
+
+// SHA3-256 of serializeBlockWitness().
+std::array<uint8_t, 32> computeWitnessRoot(const Block& block);
+
+// Base section: header fields, block_hash, witness_root and tx bodies.
+std::vector<uint8_t> serializeBlockBase(const Block& block);
+
+// Serialize the full block (including block_hash) to measure its size:
+// base section, a 1-byte witness-present flag, then the witness section
+// if it has not been pruned.
 std::vector<uint8_t> serializeFullBlock(const Block& block);
+
+// Streaming forms of the serializers above, for any ByteWriter over
+// SizeSink, BufferSink, HashSink or FileSink (instantiated in block.cpp).
+template <typename Writer> void encodeBlockWitness(Writer& w, const Block& block);
+template <typename Writer> void encodeBlockBase(Writer& w, const Block& block);
+template <typename Writer> void encodeFullBlock(Writer& w, const Block& block);
+template <typename Writer> void encodeBlockHeader(Writer& w, const BlockHeader& header);
+
+// Body section as it appears in a full block after witness_root: tx
+// bodies, witness flag, witness. decodeBlockBody reads the same bytes.
+template <typename Writer> void encodeBlockBody(Writer& w, const Block& block);
+BlockBody decodeBlockBody(ByteReader& r);
+
+// Exact size of serializeFullBlock(block), without encoding it.
+size_t fullBlockSize(const Block& block);
+
+// Inverse of serializeFullBlock. Throws std::runtime_error on truncated or
+// malformed input (including a body whose length field disagrees with its
+// contents, or trailing bytes). A block stored without its witness comes
+// back with witness_pruned set.
+Block deserializeFullBlock(const std::vector<uint8_t>& data);
+
+// Drop all signatures and mark the block as pruned. Cached tx encodings
+// go too.
+void pruneBlockWitness(Block& block);
+
+// Release every tx's cached encoding (a body copy with both public keys).
+// Called when a block is stored: the cache only pays off while a tx is
+// being signed and checked, and would roughly double per-tx memory.
+void dropTxEncodings(Block& block);
+
+// Approximate heap + inline bytes held by a Block in memory, including
+// cached tx encodings (each counted once per block, even if shared).
+size_t blockMemoryFootprint(const Block& block);
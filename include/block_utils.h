@@ -1,11 +1,13 @@
 #pragma once
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
-// Append 32-bit / 64-bit integers in little-endian form
-void appendUint32(std::vector<uint8_t>& out, uint32_t v);
-void appendUint64(std::vector<uint8_t>& out, uint64_t v);
+// Integer/byte encoding lives in byte_codec.h (ByteWriter/ByteReader).
+
+// Metrics hook: serializers report how many bytes they produced.
+void countSerializedBytes(size_t n);
 
 // 32-byte hash used for block hashing.
 // Now implemented as SHA3-256 over the input bytes.
@@ -1,25 +1,95 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "block.h"
 #include "crypto.h"
+#include "crypto_registry.h"
+
+// "Assume-valid" checkpoint: a block the operator trusts by hash.
+// During syncBlocks, blocks up to and including it only get linkage and
+// block-hash checks; their signatures are not verified.
+struct AssumeValidCheckpoint {
+    uint32_t height = 0;
+    std::array<uint8_t, 32> block_hash{};
+};
+
+struct SyncResult {
+    size_t appended = 0;          // blocks added to the chain
+    size_t sig_checks_skipped = 0; // of those, blocks accepted via the checkpoint
+    bool checkpoint_used = false; // false => everything was fully verified
+};
 
 class Blockchain {
 public:
+    // Single-scheme chain: every tx must be signed with 'crypto'.
     explicit Blockchain(std::shared_ptr<Crypto> crypto);
+    // Mixed-scheme chain: tx.scheme selects the backend from 'registry'.
+    explicit Blockchain(CryptoRegistry registry);
 
     const Block& genesisBlock() const { return chain_.front(); }
     const Block& latestBlock() const { return chain_.back(); }
+    const CryptoRegistry& registry() const { return registry_; }
+    const std::vector<Block>& blocks() const { return chain_; }
 
     // Create a new block on top of the latest one (for us: block 1)
     Block createBlockWithTransactions(const std::vector<Transaction>& txs);
 
-    // Validate a block: linkage + hash + all transaction signatures.
+    // Validate a block: linkage + hash + witness root + all transaction
+    // signatures. A block whose witness was pruned cannot be validated.
     bool validateBlock(const Block& block) const;
 
+    // validateBlock, then append. Returns false and leaves the chain
+    // unchanged if the block is invalid.
+    bool appendBlock(const Block& block);
+
+    // Append a block whose signatures the caller has already checked with
+    // verifyBlockSignatures(registry(), block), e.g. on another thread.
+    // Linkage, block hash and witness root are still checked here.
+    bool appendPreverifiedBlock(Block block);
+
+    void setAssumeValid(const AssumeValidCheckpoint& cp);
+    void clearAssumeValid() { has_assume_valid_ = false; }
+
+    // Append 'blocks' in order, stopping at the first invalid one.
+    // If an assume-valid checkpoint is set and 'blocks' contains a block at
+    // the checkpoint height whose hash chain (linkage + recomputed hashes)
+    // reaches back to our tip and whose hash equals the trusted hash, that
+    // prefix is appended without signature checks (witness data, if
+    // present, must still match its witness_root). Any mismatch (wrong hash,
+    // broken linkage, checkpoint not in 'blocks') falls back to full
+    // verification of every block.
+    SyncResult syncBlocks(const std::vector<Block>& blocks);
+
+    // Keep witness data only for the newest 'depth' blocks; older blocks
+    // are pruned as the chain grows. 0 disables pruning (the default).
+    void setWitnessPruneDepth(size_t depth);
+
 private:
-    Block makeGenesisBlock() const;
+    void pruneOldWitnesses();
 
     std::vector<Block> chain_;
-    std::shared_ptr<Crypto> crypto_;
+    CryptoRegistry registry_;
+
+    bool has_assume_valid_ = false;
+    AssumeValidCheckpoint assume_valid_;
+
+    size_t witness_prune_depth_ = 0;
+    size_t first_unpruned_ = 0; // chain_ position pruning has reached
 };
+
+// The fixed genesis block every chain (and fork tree) starts from.
+Block makeGenesisBlock();
+
+// Linkage (index, prev_hash) of 'block' on top of 'prev' + recomputed block hash.
+// No signature checks.
+bool checkLinkageAndHash(const Block& prev, const Block& block);
+
+// True if the block's witness data matches witness_root, or was pruned.
+bool checkWitness(const Block& block);
+
+// Verify every transaction signature in 'block'. Transactions are grouped
+// by scheme tag and each group goes through that backend's verifyBatch.
+// Fails if any tx uses a scheme that is not registered.
+bool verifyBlockSignatures(const CryptoRegistry& registry, const Block& block);
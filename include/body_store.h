@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "block.h"
+#include "byte_codec.h"
+#include "mapped_file.h"
+
+// Append-only file of block bodies (encodeBlockBody), one per height,
+// memory-mapped on open so a body is decoded only when it is asked for.
+// Pairs with HeaderChain, which keeps the headers in memory.
+//
+// Layout (little-endian):
+//   header  (8 bytes): magic "PQBS", version
+//   bodies  back to back, height 0 first
+//   offsets (count + 1) x u64: file offset of each body, then of the end
+//   trailer (16 bytes): count, file offset of the offsets table
+
+class BodyStoreWriter {
+public:
+    // Create (or truncate) 'path'. Throws std::runtime_error on failure.
+    explicit BodyStoreWriter(const std::string& path);
+
+    // Bodies must be added in height order from 0: block.index == count().
+    void add(const Block& block);
+    size_t count() const { return offsets_.size() - 1; }
+
+    // Write the offsets table and trailer. Nothing can be added after.
+    void finish();
+
+private:
+    std::string path_;
+    std::ofstream file_;
+    FileSink sink_;
+    ByteWriter<FileSink> w_;
+    std::vector<uint64_t> offsets_;
+    bool finished_ = false;
+};
+
+class BodyStore {
+public:
+    // Map 'path' read-only. Throws std::runtime_error on a malformed file.
+    static std::shared_ptr<const BodyStore> open(const std::string& path);
+
+    size_t size() const { return count_; }
+    size_t fileSize() const { return file_.size(); }
+    size_t bodySize(uint32_t height) const;
+
+    // Decode the body at 'height'. Throws if out of range or malformed;
+    // the caller checks it against the header (bodyMatchesHeader).
+    BlockBody load(uint32_t height) const;
+
+private:
+    BodyStore(MappedFile file, const std::string& path);
+
+    uint64_t offset(size_t i) const;
+
+    MappedFile file_;
+    size_t count_ = 0;
+    const uint8_t* offsets_ = nullptr;
+};
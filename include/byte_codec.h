@@ -0,0 +1,209 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <stdexcept>
+#include <vector>
+#include <oqs/sha3.h>
+
+// Serialization layer. Every encoder is written once against ByteWriter<Sink>
+// and can then be run with
+//   SizeSink   - exact encoded size, no bytes written (sizing pass)
+//   BufferSink - fills a presized buffer in place
+//   HashSink   - streams into SHA3-256 without materialising the bytes
+//   FileSink   - streams into an std::ostream through a small buffer
+// All integers are little-endian (the repo's original wire format).
+
+class SizeSink {
+public:
+    void put(const uint8_t*, size_t n) { size_ += n; }
+    size_t size() const { return size_; }
+private:
+    size_t size_ = 0;
+};
+
+// Writes into [data, data + capacity). Overflow is a sizing bug and throws.
+class BufferSink {
+public:
+    BufferSink(uint8_t* data, size_t capacity) : p_(data), end_(data + capacity) {}
+    void put(const uint8_t* src, size_t n) {
+        if (static_cast<size_t>(end_ - p_) < n) {
+            throw std::runtime_error("BufferSink: write past presized buffer");
+        }
+        std::memcpy(p_, src, n);
+        p_ += n;
+    }
+    size_t remaining() const { return static_cast<size_t>(end_ - p_); }
+private:
+    uint8_t* p_;
+    uint8_t* end_;
+};
+
+// Incremental SHA3-256. Small writes are staged so the sponge is not fed
+// eight bytes at a time. Records the same hash metrics as simpleHash32.
+class HashSink {
+public:
+    HashSink();
+    ~HashSink();
+    HashSink(const HashSink&) = delete;
+    HashSink& operator=(const HashSink&) = delete;
+
+    void put(const uint8_t* src, size_t n);
+    std::array<uint8_t, 32> finish(); // call once
+
+private:
+    void flush();
+
+    OQS_SHA3_sha3_256_inc_ctx ctx_;
+    std::array<uint8_t, 256> stage_;
+    size_t staged_ = 0;
+    uint64_t total_ = 0;
+    uint64_t start_ns_;
+    bool finished_ = false;
+};
+
+class FileSink {
+public:
+    explicit FileSink(std::ostream& os) : os_(os) {}
+    ~FileSink() { drain(); } // errors are only reported by flush()
+    FileSink(const FileSink&) = delete;
+    FileSink& operator=(const FileSink&) = delete;
+
+    void put(const uint8_t* src, size_t n);
+    void flush();   // throws std::runtime_error if the stream failed
+
+private:
+    void drain();
+
+    std::ostream& os_;
+    std::array<uint8_t, 64 * 1024> buf_;
+    size_t used_ = 0;
+};
+
+template <typename Sink>
+class ByteWriter {
+public:
+    explicit ByteWriter(Sink& sink) : sink_(sink) {}
+
+    void u8(uint8_t v) { sink_.put(&v, 1); }
+    void u32(uint32_t v) {
+        uint8_t b[4];
+        for (int i = 0; i < 4; ++i) b[i] = static_cast<uint8_t>(v >> (8 * i));
+        sink_.put(b, 4);
+    }
+    void u64(uint64_t v) {
+        uint8_t b[8];
+        for (int i = 0; i < 8; ++i) b[i] = static_cast<uint8_t>(v >> (8 * i));
+        sink_.put(b, 8);
+    }
+    void raw(const uint8_t* p, size_t n) { sink_.put(p, n); }
+    void raw(const std::vector<uint8_t>& v) { sink_.put(v.data(), v.size()); }
+    template <size_t N>
+    void raw(const std::array<uint8_t, N>& a) { sink_.put(a.data(), N); }
+    // u64 length + bytes
+    void bytes(const std::vector<uint8_t>& v) {
+        u64(static_cast<uint64_t>(v.size()));
+        raw(v);
+    }
+
+    Sink& sink() { return sink_; }
+
+private:
+    Sink& sink_;
+};
+
+// Run 'encode(ByteWriter<...>&)' twice: once to size, once into an exactly
+// sized vector.
+template <typename EncodeFn>
+std::vector<uint8_t> encodeToVector(EncodeFn&& encode) {
+    SizeSink size;
+    ByteWriter<SizeSink> sizer(size);
+    encode(sizer);
+
+    std::vector<uint8_t> out(size.size());
+    BufferSink buf(out.data(), out.size());
+    ByteWriter<BufferSink> w(buf);
+    encode(w);
+    return out;
+}
+
+template <typename EncodeFn>
+std::array<uint8_t, 32> encodeToHash(EncodeFn&& encode) {
+    HashSink h;
+    ByteWriter<HashSink> w(h);
+    encode(w);
+    return h.finish();
+}
+
+// Bounds-checked little-endian reader. Every failure throws
+// std::runtime_error prefixed with 'context' (e.g. "loadWorkload").
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size, const char* context)
+        : p_(data), left_(size), context_(context) {}
+    ByteReader(const std::vector<uint8_t>& data, const char* context)
+        : ByteReader(data.data(), data.size(), context) {}
+
+    uint8_t u8() {
+        need(1);
+        --left_;
+        return *p_++;
+    }
+    uint32_t u32() {
+        need(4);
+        uint32_t v = 0;
+        for (int i = 0; i < 4; ++i) v |= static_cast<uint32_t>(p_[i]) << (8 * i);
+        advance(4);
+        return v;
+    }
+    uint64_t u64() {
+        need(8);
+        uint64_t v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(p_[i]) << (8 * i);
+        advance(8);
+        return v;
+    }
+    void raw(uint8_t* out, size_t n) {
+        need(n);
+        std::memcpy(out, p_, n);
+        advance(n);
+    }
+    template <size_t N>
+    void raw(std::array<uint8_t, N>& a) { raw(a.data(), N); }
+    // u64 length + bytes
+    std::vector<uint8_t> bytes() {
+        uint64_t n = u64();
+        need(n);
+        std::vector<uint8_t> out(p_, p_ + n);
+        advance(static_cast<size_t>(n));
+        return out;
+    }
+    // Reader over the next n bytes; this reader moves past them.
+    ByteReader sub(uint64_t n) {
+        need(n);
+        ByteReader r(p_, static_cast<size_t>(n), context_);
+        advance(static_cast<size_t>(n));
+        return r;
+    }
+
+    size_t remaining() const { return left_; }
+    bool done() const { return left_ == 0; }
+    [[noreturn]] void fail(const char* what) const;
+
+private:
+    void need(uint64_t n) const {
+        if (left_ < n) {
+            fail("truncated input");
+        }
+    }
+    void advance(size_t n) {
+        p_ += n;
+        left_ -= n;
+    }
+
+    const uint8_t* p_;
+    size_t left_;
+    const char* context_;
+};
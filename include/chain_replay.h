@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "block.h"
+#include "blockchain.h"
+
+// Replays serialized blocks (serializeFullBlock output) onto a chain.
+//
+// Signature checks of a block do not depend on earlier blocks, so with
+// threads > 0 a thread pool decodes and verifies the signatures of up to
+// 'window' upcoming blocks while the calling thread checks linkage, block
+// hash and witness root and commits them strictly in order.
+// threads == 0 is the plain sequential path (decode + appendBlock).
+
+struct ReplayResult {
+    size_t blocks = 0;      // blocks appended
+    size_t txs = 0;         // transactions in those blocks
+    uint64_t elapsed_us = 0;
+    bool ok = true;         // false => stopped at the first bad block
+    size_t failed_at = 0;   // position in the input of that block (if !ok)
+
+    double blocksPerSecond() const { return elapsed_us ? blocks * 1e6 / elapsed_us : 0.0; }
+    double txPerSecond() const { return elapsed_us ? txs * 1e6 / elapsed_us : 0.0; }
+};
+
+// 'window' = 0 picks 4 blocks per thread.
+ReplayResult replayChain(Blockchain& chain,
+                         const std::vector<std::vector<uint8_t>>& serialized_blocks,
+                         unsigned threads, size_t window = 0);
+
+// Chain file: magic "PQCH", version, block count, then (u64 length +
+// serializeFullBlock bytes) per block. Throws std::runtime_error on I/O or
+// format errors.
+void saveChainFile(const std::string& path, const std::vector<Block>& blocks);
+std::vector<std::vector<uint8_t>> loadChainFile(const std::string& path);
@@ -1,7 +1,29 @@
 #pragma once
 #include <cstdint>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
+#include "algo_config.h"
+
+// One (msg, sig, pk) triple for verifyBatch. Pointers are borrowed.
+struct VerifyItem {
+    const std::vector<uint8_t>* msg;
+    const std::vector<uint8_t>* sig;
+    const std::vector<uint8_t>* pk;
+};
+
+// A secret key decoded/expanded once by Crypto::prepareSigningKey, for
+// signing many messages with the same key. Backends derive from it; the
+// default keeps a plain copy of the encoded key.
+struct PreparedKey {
+    virtual ~PreparedKey() = default;
+    SchemeId scheme = SchemeId::NONE;
+};
+
+struct EncodedPreparedKey : PreparedKey {
+    std::vector<uint8_t> sk;
+};
 
 class Crypto {
 public:
@@ -20,10 +42,52 @@ public:
            const std::vector<uint8_t>& sig,
            const std::vector<uint8_t>& pk) = 0;
 
+    // sign() for a secret key that lives outside a vector (e.g. a mapped
+    // keystore record). The default copies it; backends sign in place.
+    virtual std::vector<uint8_t>
+    signWithKey(const std::vector<uint8_t>& msg, const uint8_t* sk, size_t sk_len) {
+        return sign(msg, std::vector<uint8_t>(sk, sk + sk_len));
+    }
+
+    // Decode/expand 'sk' once. Backends whose library has no expanded-key
+    // entry point return a copy of the encoded key.
+    virtual std::shared_ptr<const PreparedKey>
+    prepareSigningKey(const std::vector<uint8_t>& sk) {
+        auto key = std::make_shared<EncodedPreparedKey>();
+        key->scheme = schemeId();
+        key->sk = sk;
+        return key;
+    }
+
+    // Same signature as sign(msg, sk) for the key 'key' was prepared from.
+    // Throws if 'key' was prepared by a different scheme.
+    virtual std::vector<uint8_t>
+    signPrepared(const std::vector<uint8_t>& msg, const PreparedKey& key) {
+        const auto* k = dynamic_cast<const EncodedPreparedKey*>(&key);
+        if (!k || key.scheme != schemeId()) {
+            throw std::runtime_error("signPrepared: key was prepared for another scheme");
+        }
+        return sign(msg, k->sk);
+    }
+
+    // Verify a group of signatures; true only if every one is valid.
+    // None of our schemes has a real batch verifier, so the default just
+    // loops, but backends can override it.
+    virtual bool
+    verifyBatch(const std::vector<VerifyItem>& items) {
+        for (const auto& it : items) {
+            if (!verify(*it.msg, *it.sig, *it.pk)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     // Metadata for reporting
     virtual std::string name() const = 0;    // e.g. "ML-DSA-44"
     virtual std::string family() const = 0;  // "ML-DSA", "Falcon", "Hawk"
     virtual std::string variant() const = 0; // "44", "512", etc.
+    virtual SchemeId schemeId() const = 0;   // tag stored in transactions
 
     virtual size_t publicKeySize() const = 0;
     virtual size_t secretKeySize() const = 0;
@@ -0,0 +1,28 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+#include "algo_config.h"
+#include "crypto.h"
+
+// Signature backends indexed by SchemeId, so a chain can validate
+// transactions from accounts of different schemes.
+class CryptoRegistry {
+public:
+    CryptoRegistry() = default;
+
+    // Register a backend under its own schemeId(); replaces any previous one.
+    void add(std::shared_ptr<Crypto> crypto);
+
+    // nullptr if no backend is registered for 'id'.
+    std::shared_ptr<Crypto> get(SchemeId id) const;
+    bool contains(SchemeId id) const;
+
+    std::vector<SchemeId> schemes() const;
+
+    // Registry with one backend per config (built via createCrypto).
+    static CryptoRegistry fromConfigs(const std::vector<AlgoConfig>& cfgs);
+
+private:
+    std::array<std::shared_ptr<Crypto>, SCHEME_ID_COUNT> backends_{};
+};
@@ -0,0 +1,101 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "block.h"
+#include "crypto.h"
+#include "crypto_registry.h"
+#include "ledger_state.h"
+
+// Block tree indexed by block hash, with a fork-choice rule and ledger
+// state kept for the active chain.
+//
+// A block is checked once when it is added (linkage to its parent, block
+// hash, witness root, every signature). Only state (nonce ordering) is
+// checked when it is connected. Every connected block keeps an undo
+// journal, so a reorg disconnects and reconnects blocks without
+// re-verifying any signature.
+
+enum class ForkChoice {
+    LONGEST,  // most blocks
+    HEAVIEST  // most weight; a block weighs 1 + its tx count (there is no PoW)
+};
+
+enum class AddBlockStatus {
+    ADDED_TO_TIP, // extended the active chain
+    REORGED,      // became the new tip of a different branch
+    SIDE_BRANCH,  // stored, but the active chain is still better
+    DUPLICATE,
+    ORPHAN,       // parent unknown (not stored)
+    INVALID       // failed a check. Not stored, unless it only failed the
+                  // state checks on connect: then it stays in the tree,
+                  // marked invalid, and the old tip is kept
+};
+
+struct ReorgStats {
+    size_t disconnected = 0;
+    size_t connected = 0;
+    uint64_t elapsed_us = 0;
+};
+
+struct AddBlockResult {
+    AddBlockStatus status = AddBlockStatus::INVALID;
+    ReorgStats reorg; // filled for REORGED (and ADDED_TO_TIP: connected = 1)
+};
+
+class ForkTree {
+public:
+    explicit ForkTree(std::shared_ptr<Crypto> crypto, ForkChoice rule = ForkChoice::LONGEST);
+    explicit ForkTree(CryptoRegistry registry, ForkChoice rule = ForkChoice::LONGEST);
+
+    AddBlockResult addBlock(const Block& block);
+
+    // Block on top of 'parent' with the given txs. The parent does not
+    // have to be in a tree yet, so whole branches can be built up front.
+    // Not added; pass the result to addBlock.
+    static Block createBlock(const Block& parent,
+                             const std::vector<Transaction>& txs,
+                             uint64_t timestamp);
+
+    const Block& tip() const { return tip_->block; }
+    const Block& genesis() const { return genesis_->block; }
+    bool contains(const std::array<uint8_t, 32>& hash) const { return nodes_.count(hash) != 0; }
+    size_t size() const { return nodes_.size(); }
+
+    // Active chain from genesis to tip.
+    std::vector<const Block*> activeChain() const;
+
+    const LedgerState& state() const { return state_; }
+
+    // Signature checks run so far (one per tx of every block accepted or
+    // rejected by addBlock); reorgs never add to it.
+    uint64_t signaturesVerified() const { return sigs_verified_; }
+
+private:
+    struct Node {
+        Block block;
+        Node* parent = nullptr;
+        uint64_t height = 0;
+        uint64_t chain_weight = 0; // sum of block weights from genesis
+        bool invalid = false;      // failed state checks when connected
+        TxAccounts accounts;       // sender/receiver ids, computed once
+        UndoJournal undo;          // valid while the block is connected
+    };
+
+    void init();
+    bool better(const Node& a, const Node& b) const;
+    // Make 'target' the tip. On a state failure the old chain is restored
+    // and false is returned.
+    bool reorgTo(Node* target, ReorgStats& stats);
+
+    CryptoRegistry registry_;
+    ForkChoice rule_;
+    std::unordered_map<std::array<uint8_t, 32>, std::unique_ptr<Node>, BlockHashHasher> nodes_;
+    Node* genesis_ = nullptr;
+    Node* tip_ = nullptr;
+    LedgerState state_;
+    uint64_t sigs_verified_ = 0;
+};
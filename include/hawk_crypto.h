@@ -1,5 +1,6 @@
 #pragma once
 #include "crypto.h"
+#include "metrics.h"
 #include <string>
 #include <cstddef>
 #include <cstdint>
@@ -21,6 +22,18 @@ public:
     sign(const std::vector<uint8_t>& msg,
          const std::vector<uint8_t>& sk) override;
 
+    std::vector<uint8_t>
+    signWithKey(const std::vector<uint8_t>& msg,
+                const uint8_t* sk, size_t sk_len) override;
+
+    // Expands the private basis once (hawk_expand_privkey); signPrepared
+    // then uses hawk_sign_finish_alt and skips the per-call expansion.
+    std::shared_ptr<const PreparedKey>
+    prepareSigningKey(const std::vector<uint8_t>& sk) override;
+
+    std::vector<uint8_t>
+    signPrepared(const std::vector<uint8_t>& msg, const PreparedKey& key) override;
+
     bool
     verify(const std::vector<uint8_t>& msg,
            const std::vector<uint8_t>& sig,
@@ -29,6 +42,7 @@ public:
     std::string name() const override;
     std::string family() const override { return "Hawk"; }
     std::string variant() const override { return variant_; }
+    SchemeId schemeId() const override;
 
     size_t publicKeySize() const override;
     size_t secretKeySize() const override;
@@ -45,7 +59,7 @@ private:
     size_t tmp_s_;
     size_t tmp_v_;
     size_t tmp_len_;
+    size_t expanded_len_;
 
-    // RNG context (same as your bench)
-    shake_context rng_;
+    CryptoMetrics metrics_; // keygen/sign/verify hooks, labelled by name()
 };
@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "block.h"
+
+class BodyStore;
+
+// Chain index that holds only BlockHeaders (BLOCK_HEADER_SIZE bytes of
+// data each) plus a hash -> height map. Syncing it checks linkage and
+// header hashes but touches no transaction data; bodies are read from a
+// BodyStore when a block is actually needed and checked against the
+// header's body_root / witness_root then.
+class HeaderChain {
+public:
+    // Starts at the header of makeGenesisBlock().
+    HeaderChain();
+    explicit HeaderChain(const BlockHeader& genesis);
+
+    // Append if 'header' extends the tip: next index, prev_hash == tip
+    // hash and block_hash == computeHeaderHash(header). Returns false and
+    // leaves the chain unchanged otherwise.
+    bool append(const BlockHeader& header);
+
+    // Append in order, stopping at the first header that does not fit.
+    // Returns the number appended.
+    size_t appendAll(const std::vector<BlockHeader>& headers);
+
+    void reserve(size_t headers);
+
+    const BlockHeader& tip() const { return headers_.back(); }
+    const BlockHeader& at(uint32_t height) const; // throws if out of range
+    size_t size() const { return headers_.size(); }
+
+    // Sets 'height' if 'hash' is on the chain.
+    bool find(const std::array<uint8_t, 32>& hash, uint32_t& height) const;
+
+    // Full block at 'height': header from memory, body from 'bodies'.
+    // Throws std::runtime_error if the body does not match the header.
+    Block loadBlock(uint32_t height, const BodyStore& bodies) const;
+
+    // Approximate heap + object bytes held (headers and the hash index).
+    size_t memoryFootprint() const;
+
+private:
+    std::vector<BlockHeader> headers_;
+    std::unordered_map<std::array<uint8_t, 32>, uint32_t, BlockHashHasher> by_hash_;
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "algo_config.h"
+#include "crypto.h"
+#include "metrics.h"
+
+struct KeypairPoolStats {
+    uint64_t hits = 0;          // take/tryTake served from a ready keypair
+    uint64_t misses = 0;        // take had to wait, or tryTake found the pool empty
+    uint64_t generated = 0;     // keypairs produced by the workers
+    uint64_t keygen_total_us = 0; // time the workers spent inside generateKeypair
+    uint64_t uptime_us = 0;     // wall time since the pool was started
+
+    double hitRate() const {
+        uint64_t n = hits + misses;
+        return n ? static_cast<double>(hits) / n : 0.0;
+    }
+    // Keypairs per second actually delivered into the pool (wall clock).
+    double refillPerSecond() const {
+        return uptime_us ? generated * 1e6 / uptime_us : 0.0;
+    }
+};
+
+// Keeps up to 'capacity' keypairs ready, refilled by background threads.
+// Each worker owns its own Crypto instance (from createCrypto), so workers
+// share no backend state.
+class KeypairPool {
+public:
+    using Keypair = std::pair<std::vector<uint8_t>, std::vector<uint8_t>>; // (public, secret)
+
+    KeypairPool(const AlgoConfig& cfg, size_t capacity, size_t worker_count = 1);
+    ~KeypairPool();
+
+    KeypairPool(const KeypairPool&) = delete;
+    KeypairPool& operator=(const KeypairPool&) = delete;
+
+    // Blocks until a keypair is ready.
+    Keypair take();
+
+    // Non-blocking: returns false (and counts a miss) if the pool is empty.
+    bool tryTake(Keypair& out);
+
+    // Blocks until the pool is at capacity (e.g. before a benchmark burst).
+    void waitUntilFull();
+
+    size_t size() const;
+    size_t capacity() const { return capacity_; }
+    SchemeId schemeId() const { return scheme_; }
+
+    KeypairPoolStats stats() const;
+
+private:
+    void workerLoop(std::shared_ptr<Crypto> crypto);
+
+    SchemeId scheme_;
+    size_t capacity_;
+    uint64_t start_us_;
+
+    mutable std::mutex mu_;
+    std::condition_variable not_full_;  // workers wait here
+    std::condition_variable not_empty_; // take() waits here
+    std::deque<Keypair> ready_;
+    size_t in_flight_ = 0;              // keygens currently running
+    bool stop_ = false;
+
+    KeypairPoolStats stats_;
+    Counter* hit_counter_;  // exported as cache hit/miss counters
+    Counter* miss_counter_;
+    Gauge* ready_gauge_;
+    std::vector<std::thread> workers_;
+};
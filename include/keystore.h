@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "algo_config.h"
+#include "ledger_state.h"
+#include "mapped_file.h"
+
+// On-disk keystore for benchmarks with many accounts: one scheme per
+// file, fixed-size records, memory-mapped on open so loading costs no
+// parsing or copying. Keys are stored in the clear; this is for test
+// accounts, not real funds.
+//
+// Layout (little-endian):
+//   header  (64 bytes): magic "PQKS", version, scheme id, pk size,
+//                       sk size, record size, record count
+//   records (count x record size): account id (32) | pk | sk, padded to 8
+//   index   (count x 40): account id (32) | u64 record number, sorted by id
+
+// Pointers into the mapping; valid while the Keystore is alive.
+struct KeystoreEntry {
+    const uint8_t* id = nullptr; // 32 bytes
+    const uint8_t* pk = nullptr;
+    size_t pk_len = 0;
+    const uint8_t* sk = nullptr;
+    size_t sk_len = 0;
+
+    AccountId accountId() const;
+    std::vector<uint8_t> publicKey() const;
+};
+
+struct KeystoreGenStats {
+    size_t keys = 0;
+    unsigned threads = 0;
+    uint64_t elapsed_us = 0;
+
+    double keysPerSecond() const { return elapsed_us ? keys * 1e6 / elapsed_us : 0.0; }
+};
+
+class Keystore {
+public:
+    // Generate 'count' keypairs for 'cfg' on 'threads' workers (each with
+    // its own backend) straight into a new file at 'path'.
+    static KeystoreGenStats generate(const std::string& path, const AlgoConfig& cfg,
+                                     size_t count, unsigned threads);
+
+    // Map 'path' read-only. Throws std::runtime_error on a malformed file.
+    static std::shared_ptr<const Keystore> open(const std::string& path);
+
+    SchemeId scheme() const { return scheme_; }
+    size_t size() const { return count_; }
+    size_t publicKeySize() const { return pk_len_; }
+    size_t secretKeySize() const { return sk_len_; }
+    size_t fileSize() const { return file_.size(); }
+
+    // Entry by record number (generation order). Throws if out of range.
+    KeystoreEntry entry(size_t index) const;
+
+    // Binary search of the index; sets 'index' to the record number.
+    bool find(const AccountId& id, size_t& index) const;
+
+private:
+    explicit Keystore(MappedFile file, const std::string& path);
+
+    MappedFile file_;
+    SchemeId scheme_ = SchemeId::NONE;
+    size_t pk_len_ = 0;
+    size_t sk_len_ = 0;
+    size_t record_len_ = 0;
+    size_t count_ = 0;
+    const uint8_t* records_ = nullptr;
+    const uint8_t* index_ = nullptr;
+};
@@ -0,0 +1,56 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "block.h"
+
+// 32-byte account id: SHA3-256 of the account's public key.
+using AccountId = std::array<uint8_t, 32>;
+AccountId accountIdFor(const std::vector<uint8_t>& pubkey);
+
+// The repo has no coin issuance, so balances are net transfer totals and
+// may go negative. The rules that are enforced are nonce ordering (every
+// sender's nonces must be 1, 2, 3, ... with no gaps or replays) and that
+// amounts and balances stay within int64.
+struct AccountState {
+    int64_t balance = 0;
+    uint64_t nonce = 0; // last nonce used by this account as a sender
+};
+
+// Records the prior state of every account a block touched, so the block
+// can be disconnected by replaying the entries in reverse.
+struct UndoJournal {
+    struct Entry {
+        AccountId id;
+        bool existed;      // false => the account was created by this block
+        AccountState prev;
+    };
+    std::vector<Entry> entries;
+};
+
+// (sender, receiver) ids for each tx of a block, in tx order. Computed once
+// per block so that reconnecting it does not re-hash public keys.
+using TxAccounts = std::vector<std::pair<AccountId, AccountId>>;
+TxAccounts txAccountsFor(const Block& block);
+
+class LedgerState {
+public:
+    // Apply every tx of 'block' (accounts from txAccountsFor(block)).
+    // On success fills 'undo' and returns true. On a nonce violation the
+    // partial changes are rolled back and false is returned; likewise for
+    // an amount above INT64_MAX or a balance that would overflow.
+    bool connectBlock(const Block& block, const TxAccounts& accounts, UndoJournal& undo);
+
+    // Reverse a block applied by connectBlock.
+    void disconnectBlock(const UndoJournal& undo);
+
+    // Zero state if the account was never seen.
+    AccountState account(const AccountId& id) const;
+    size_t accountCount() const { return accounts_.size(); }
+
+private:
+    AccountState& touch(const AccountId& id, UndoJournal& undo);
+
+    std::map<AccountId, AccountState> accounts_;
+};
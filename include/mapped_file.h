@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A whole file mapped into memory: mmap on POSIX, CreateFileMapping +
+// MapViewOfFile on Windows. Move-only; the mapping is released on
+// destruction. Throws std::runtime_error on any OS failure.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map an existing file read-only. Pages are loaded on first touch.
+    static MappedFile openReadOnly(const std::string& path);
+
+    // Create (or truncate) 'path' to 'size' bytes and map it read-write.
+    static MappedFile create(const std::string& path, size_t size);
+
+    const uint8_t* data() const { return data_; }
+    uint8_t* mutableData() { return writable_ ? data_ : nullptr; }
+    size_t size() const { return size_; }
+
+    // Write dirty pages of a read-write mapping back to the file.
+    void flush();
+
+private:
+    void release() noexcept;
+
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool writable_ = false;
+#if defined(_WIN32)
+    void* file_ = nullptr;    // HANDLE
+    void* mapping_ = nullptr; // HANDLE
+#else
+    int fd_ = -1;
+#endif
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Opt-in memory accounting. Built with PQBC_MEM_ACCOUNTING defined,
+// mem_accounting.cpp replaces the global operator new/delete (adding a
+// 16-byte header to every allocation); every allocation is charged to the
+// phase active on the allocating thread (see MemPhaseScope), and frees are
+// charged back to that same phase. Nothing is counted until
+// setMemAccountingEnabled(true). Without the define the default allocator
+// is used and accounting cannot be enabled; the RSS readers always work.
+
+enum class MemPhase : uint8_t {
+    NONE = 0,     // untagged
+    KEYGEN,
+    SIGN,
+    BUILD_BLOCK,
+    HASH,
+    SERIALIZE,
+    VALIDATE,
+    COUNT
+};
+
+struct MemPhaseStats {
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    uint64_t bytes_allocated = 0;
+    uint64_t bytes_freed = 0;
+    // Process peak RSS so far (monotonic, process-wide), read when the
+    // phase last ended; 0 = never sampled.
+    uint64_t peak_rss_bytes = 0;
+    // Largest change of current RSS between entry and exit of one scope.
+    int64_t rss_growth_bytes = 0;
+
+    int64_t liveBytes() const {
+        return static_cast<int64_t>(bytes_allocated) - static_cast<int64_t>(bytes_freed);
+    }
+};
+
+// True if built with PQBC_MEM_ACCOUNTING. Otherwise enabling is a no-op.
+bool memAccountingBuiltIn();
+void setMemAccountingEnabled(bool on);
+bool memAccountingEnabled();
+
+const char* memPhaseName(MemPhase p);
+MemPhaseStats memPhaseStats(MemPhase p);
+void resetMemPhaseStats();
+
+// Tags allocations on this thread with 'phase' until destroyed (nests).
+// With sample_rss (and accounting enabled), current RSS is read on entry
+// and exit and the process peak on exit; leave it off for per-operation
+// scopes inside hot loops.
+class MemPhaseScope {
+public:
+    explicit MemPhaseScope(MemPhase phase, bool sample_rss = true);
+    ~MemPhaseScope();
+
+    MemPhaseScope(const MemPhaseScope&) = delete;
+    MemPhaseScope& operator=(const MemPhaseScope&) = delete;
+
+private:
+    MemPhase phase_;
+    MemPhase prev_;
+    bool sample_rss_;
+    size_t rss_at_entry_ = 0;
+};
+
+// Resident set size from /proc/self/status (Linux) or
+// GetProcessMemoryInfo (Windows). 0 if unavailable.
+size_t currentRssBytes();
+size_t peakRssBytes();
+
+// One row per phase that saw any activity, plus process RSS.
+void printMemoryTable(std::ostream& os);
@@ -0,0 +1,165 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Lightweight runtime metrics. Registration (name -> object) takes a lock
+// once; after that every update is a relaxed atomic op, so hooks can stay
+// on in production. Callers cache the returned reference.
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+enum class MetricsFormat {
+    PROMETHEUS, // Prometheus text exposition format
+    JSON
+};
+
+class Counter {
+public:
+    void inc(uint64_t n = 1) { v_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t value() const { return v_.load(std::memory_order_relaxed); }
+private:
+    std::atomic<uint64_t> v_{0};
+};
+
+class Gauge {
+public:
+    void set(int64_t v) { v_.store(v, std::memory_order_relaxed); }
+    void add(int64_t d) { v_.fetch_add(d, std::memory_order_relaxed); }
+    int64_t value() const { return v_.load(std::memory_order_relaxed); }
+private:
+    std::atomic<int64_t> v_{0};
+};
+
+// Latency histogram in nanoseconds with power-of-two bucket bounds
+// (256 ns .. ~8.6 s) plus +Inf. Exported in seconds.
+class Histogram {
+public:
+    static constexpr size_t BUCKET_COUNT = 26; // finite buckets
+    static constexpr unsigned FIRST_BUCKET_LOG2 = 8;
+
+    void observeNanos(uint64_t ns);
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sumNanos() const { return sum_ns_.load(std::memory_order_relaxed); }
+    // Non-cumulative count of bucket i (i == BUCKET_COUNT is +Inf).
+    uint64_t bucket(size_t i) const { return buckets_[i].load(std::memory_order_relaxed); }
+    static uint64_t bucketUpperNanos(size_t i) { return 1ull << (FIRST_BUCKET_LOG2 + i); }
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT + 1> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+};
+
+class MetricsRegistry {
+public:
+    // Process-wide registry used by all built-in hooks.
+    static MetricsRegistry& global();
+
+    // Returns the existing metric if (name, labels) was already registered.
+    // References stay valid for the registry's lifetime.
+    Counter& counter(const std::string& name, const std::string& help,
+                     const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help,
+                 const MetricLabels& labels = {});
+    Histogram& histogram(const std::string& name, const std::string& help,
+                         const MetricLabels& labels = {});
+
+    std::string snapshot(MetricsFormat fmt) const;
+
+    // Write a snapshot to 'path' via a temp file + rename, so readers never
+    // see a half-written file. Returns false on I/O failure.
+    bool writeSnapshot(const std::string& path, MetricsFormat fmt) const;
+
+private:
+    enum class Kind { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+    struct Family {
+        Kind kind;
+        std::string help;
+        std::vector<std::unique_ptr<Series>> series;
+    };
+
+    Series& findOrAdd(const std::string& name, const std::string& help,
+                      const MetricLabels& labels, Kind kind);
+
+    mutable std::mutex mu_;
+    std::map<std::string, Family> families_;
+};
+
+inline MetricsRegistry& metrics() { return MetricsRegistry::global(); }
+
+// Global on/off switch for timing hooks (counters are always updated).
+// On by default.
+void setMetricsEnabled(bool on);
+bool metricsEnabled();
+
+// Monotonic nanoseconds, for latency hooks.
+uint64_t metricsNowNanos();
+
+// Records the lifetime of the scope into 'h' (skipped when disabled).
+class ScopedLatency {
+public:
+    explicit ScopedLatency(Histogram& h)
+        : h_(metricsEnabled() ? &h : nullptr),
+          start_(h_ ? metricsNowNanos() : 0) {}
+    ~ScopedLatency() {
+        if (h_) {
+            h_->observeNanos(metricsNowNanos() - start_);
+        }
+    }
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+private:
+    Histogram* h_;
+    uint64_t start_;
+};
+
+// Per-backend hooks, labelled with the algorithm name (e.g. "Falcon-512").
+struct CryptoMetrics {
+    Histogram* keygen = nullptr;
+    Histogram* sign = nullptr;
+    Histogram* verify = nullptr;
+    Counter* verified = nullptr;
+    Counter* failed = nullptr;
+
+    static CryptoMetrics forAlgorithm(const std::string& alg_name);
+};
+
+// Background thread that writes a snapshot every 'interval_ms' and once
+// more on destruction.
+class MetricsExporter {
+public:
+    MetricsExporter(std::string path, MetricsFormat fmt, unsigned interval_ms);
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+private:
+    void run();
+
+    std::string path_;
+    MetricsFormat fmt_;
+    unsigned interval_ms_;
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread thread_;
+};
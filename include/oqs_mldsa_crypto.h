@@ -1,5 +1,6 @@
 #pragma once
 #include "crypto.h"
+#include "metrics.h"
 #include <oqs/oqs.h>
 #include <string>
 
@@ -15,6 +16,10 @@ public:
     sign(const std::vector<uint8_t>& msg,
          const std::vector<uint8_t>& sk) override;
 
+    std::vector<uint8_t>
+    signWithKey(const std::vector<uint8_t>& msg,
+                const uint8_t* sk, size_t sk_len) override;
+
     bool
     verify(const std::vector<uint8_t>& msg,
            const std::vector<uint8_t>& sig,
@@ -23,6 +28,7 @@ public:
     std::string name() const override;
     std::string family() const override { return "ML-DSA"; }
     std::string variant() const override { return variant_; }
+    SchemeId schemeId() const override;
 
     size_t publicKeySize() const override;
     size_t secretKeySize() const override;
@@ -32,4 +38,6 @@ private:
     std::string variant_;       // "44", "65", "87"
     std::string oqs_alg_name_;  // "ML-DSA-44", etc.
     OQS_SIG* sig_ = nullptr;
+
+    CryptoMetrics metrics_; // keygen/sign/verify hooks, labelled by name()
 };
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Process-wide randomness for every backend. liboqs draws through
+// OQS_randombytes_custom_algorithm and Hawk through its rng callback, so
+// one switch changes where all keygen/sign randomness comes from.
+//
+//   SYSTEM        - every draw asks the OS (getrandom / BCryptGenRandom);
+//                   what liboqs does by default.
+//   BUFFERED      - per-thread SHAKE256 stream seeded from the OS on first
+//                   use and re-seeded every 1 MiB; output is handed out
+//                   from a 4 KB buffer. The default.
+//   DETERMINISTIC - per-thread SHAKE256 stream derived from a fixed seed
+//                   and the order in which threads first draw. Repeatable
+//                   when that order is (e.g. single-threaded runs); never
+//                   use it for real keys.
+//
+// Every thread keeps its own state, so draws need no locking and Hawk
+// signing is safe from any thread.
+
+enum class RngMode : uint8_t {
+    SYSTEM = 0,
+    BUFFERED,
+    DETERMINISTIC
+};
+
+// Switches the mode for all threads; each thread re-seeds on its next draw.
+void setRngMode(RngMode mode, uint64_t seed = 0);
+RngMode rngMode();
+uint64_t rngSeed(); // only meaningful in DETERMINISTIC mode
+
+// "system", "buffered", "deterministic" or "deterministic:<seed>".
+// Returns false (mode unchanged) if 'spec' is not one of those.
+bool setRngModeFromString(const std::string& spec);
+
+// e.g. "buffered" or "deterministic (seed 42)".
+std::string rngDescription();
+
+void randomBytes(uint8_t* out, size_t len);
+
+// Signature of hawk_rng; 'ctx' is ignored.
+void hawkRandomBytes(void* ctx, void* out, size_t len);
+
+// Routes liboqs' randombytes through randomBytes. Idempotent; the liboqs
+// backends call it from their constructors.
+void installOqsRandomness();
+
+struct RngCost {
+    size_t draw_bytes = 0;
+    double ns_per_draw = 0.0;
+    double mb_per_second = 0.0;
+};
+
+// Times 'draws' calls of randomBytes(draw_bytes) in the current mode.
+RngCost measureRngCost(size_t draw_bytes = 32, size_t draws = 20000);
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "algo_config.h"
+
+// Sustained end-to-end run: producer threads sign txs through Wallet into
+// a bounded mempool, one builder thread closes a block every
+// block_interval_ms or at max_block_txs (whichever comes first), and
+// validator threads verify block signatures in parallel and append the
+// blocks to a Blockchain in order. Every stage competes for the same cores
+// for the whole run, so the numbers are steady-state throughput, not the
+// per-phase timings of the other benchmarks.
+//
+// Confirmation latency of a tx runs from the start of its signing to the
+// append of its block.
+
+struct SoakConfig {
+    unsigned producers = 1;
+    unsigned validators = 1;
+    uint64_t duration_ms = 60000;
+    uint64_t block_interval_ms = 500;
+    size_t max_block_txs = 500;
+    size_t mempool_capacity = 0;     // 0 = 4 x max_block_txs; producers wait when full
+    size_t witness_prune_depth = 16; // passed to Blockchain; 0 keeps every witness
+    uint64_t sample_interval_ms = 1000;
+};
+
+// One row of the time series (values for the interval that just ended).
+struct SoakSample {
+    double t_s = 0.0;          // seconds since start
+    uint64_t committed_txs = 0; // cumulative
+    uint64_t blocks = 0;        // cumulative
+    double tps = 0.0;
+    uint64_t p50_us = 0;       // confirmation latency of this interval's txs
+    uint64_t p99_us = 0;
+    size_t mempool = 0;        // txs waiting for a block
+    size_t rss_bytes = 0;
+};
+
+struct SoakReport {
+    std::vector<SoakSample> samples;
+    uint64_t submitted_txs = 0;
+    uint64_t committed_txs = 0;
+    uint64_t blocks = 0;
+    uint64_t rejected_blocks = 0;
+    uint64_t elapsed_us = 0;
+
+    // Whole-run confirmation latency (from a fixed-size reservoir sample).
+    uint64_t p50_us = 0, p90_us = 0, p99_us = 0, p999_us = 0, max_us = 0;
+
+    // RSS after the warm-up (first 10% of the run) and at the end. The
+    // chain keeps every block in memory, so some growth per tx is expected.
+    double warm_t_s = 0.0;
+    uint64_t warm_committed_txs = 0;
+    size_t rss_warm_bytes = 0;
+    size_t rss_end_bytes = 0;
+
+    double tps() const { return elapsed_us ? committed_txs * 1e6 / elapsed_us : 0.0; }
+    double rssDriftPerMinute() const;
+    double rssGrowthPerTx() const; // bytes per tx confirmed after the warm-up
+    bool ok() const { return rejected_blocks == 0; }
+};
+
+// Runs for cfg.duration_ms with the 'algo' backend. 'on_sample', if set,
+// is called from the calling thread as each sample is taken.
+SoakReport runSoak(const AlgoConfig& algo, const SoakConfig& cfg,
+                   const std::function<void(const SoakSample&)>& on_sample = nullptr);
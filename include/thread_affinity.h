@@ -0,0 +1,8 @@
+#pragma once
+
+// Number of hardware threads (at least 1).
+unsigned hardwareThreadCount();
+
+// Pin the calling thread to logical CPU 'cpu' (taken modulo the CPU count).
+// Returns false if pinning is not supported or the OS refused.
+bool pinCurrentThreadToCpu(unsigned cpu);
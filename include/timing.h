@@ -1,5 +1,9 @@
 // include/timing.h
 #pragma once
 #include <cstdint>
+#include <vector>
 
-uint64_t nowMicros();
\ No newline at end of file
+uint64_t nowMicros();
+
+// p in [0, 100]; nearest-rank percentile of 'samples' (0 if empty).
+uint64_t percentileMicros(std::vector<uint64_t> samples, double p);
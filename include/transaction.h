@@ -1,16 +1,96 @@
 #pragma once
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <vector>
+#include "algo_config.h"
+#include "byte_codec.h"
+
+// What the signature covers.
+enum class TxSigMode : uint8_t {
+    BODY = 0,   // the full serialized body (original behaviour)
+    DIGEST = 1  // a short domain-separated message built from the tx id
+};
+
+using TxId = std::array<uint8_t, 32>;
+
+// Encodings derived from the signed fields. Built once by
+// cacheTxEncoding() and shared (not copied) between copies of the tx.
+struct TxEncoding {
+    std::vector<uint8_t> body;      // serializeTxForSigning()
+    TxId id{};                      // SHA3-256(body)
+    std::vector<uint8_t> digest_msg; // DIGEST mode only: what gets signed
+
+    // The bytes passed to Crypto::sign/verify for this tx.
+    const std::vector<uint8_t>& message() const {
+        return digest_msg.empty() ? body : digest_msg;
+    }
+};
 
 // Simple account-style transaction
 struct Transaction {
+    SchemeId scheme = SchemeId::NONE; // signature scheme of from_pubkey
+    TxSigMode sig_mode = TxSigMode::BODY;
     std::vector<uint8_t> from_pubkey;
     std::vector<uint8_t> to_pubkey;
     uint64_t amount = 0;
     uint64_t nonce  = 0;
     std::vector<uint8_t> signature; // filled after signing
+
+    // Cache of the body encoding and tx id; null until cacheTxEncoding().
+    // Not serialized, and shared between copies, so it can go stale when a
+    // field above changes: readers go through cachedTxEncoding(), which
+    // ignores a cache that no longer matches the fields. Block hashing and
+    // serialization never use it, and storing a block drops it
+    // (dropTxEncodings).
+    std::shared_ptr<const TxEncoding> encoding;
 };
 
 // Serialize the transaction fields that are covered by the signature
-// (i.e., WITHOUT the signature itself).
+// (i.e., WITHOUT the signature itself). The scheme tag is included so a
+// signature cannot be replayed under a different scheme.
+// Always builds a fresh encoding; see txEncoding() for the cached one.
 std::vector<uint8_t> serializeTxForSigning(const Transaction& tx);
+
+// Exact size of serializeTxForSigning(tx), without encoding it.
+size_t txBodySize(const Transaction& tx);
+
+// Writes the body encoding to any ByteWriter (buffer, hasher, file).
+template <typename Writer>
+void encodeTxBody(Writer& w, const Transaction& tx);
+
+// First body byte: scheme id, with the high bit set in DIGEST mode. BODY
+// mode encodings are unchanged from before the mode existed.
+uint8_t txSchemeTag(const Transaction& tx);
+void setTxSchemeTag(Transaction& tx, uint8_t tag);
+
+// Canonical 32-byte transaction id: SHA3-256 of the body (the signature is
+// not part of it). Uses the cache when it matches the fields.
+TxId computeTxId(const Transaction& tx);
+
+// Fill tx.encoding (body, id and, in DIGEST mode, the signed message).
+void cacheTxEncoding(Transaction& tx);
+void clearTxEncoding(Transaction& tx);
+
+// tx.encoding if it still matches the tx fields (one compare of the body
+// against them, much cheaper than the hash it saves), otherwise null.
+const TxEncoding* cachedTxEncoding(const Transaction& tx);
+
+// Cached encoding if it matches, otherwise a freshly built one (the tx is
+// not modified, so this is safe on shared const transactions).
+std::shared_ptr<const TxEncoding> txEncoding(const Transaction& tx);
+
+// The message that is signed: the body, or in DIGEST mode
+// "PQBC-TX-DIGEST-v1" || tx id. The prefix starts with 'P' (0x50), which
+// is never a valid body tag, so the two modes never sign the same bytes;
+// the tag also commits the id to the mode.
+std::vector<uint8_t> txSigningMessage(const Transaction& tx);
+
+template <typename Writer>
+void encodeTxBody(Writer& w, const Transaction& tx) {
+    w.u8(txSchemeTag(tx));
+    w.bytes(tx.from_pubkey); // length + bytes
+    w.bytes(tx.to_pubkey);
+    w.u64(tx.amount);
+    w.u64(tx.nonce);
+}
@@ -3,6 +3,8 @@
 #include <memory>
 #include <vector>
 #include "crypto.h"
+#include "keypair_pool.h"
+#include "keystore.h"
 #include "transaction.h"
 
 class Wallet {
@@ -11,16 +13,38 @@ public:
 
     void generateNewKeypair();
 
+    // Take a pre-generated keypair from 'pool' (same scheme as this wallet).
+    // blocking = true waits for the pool; otherwise an empty pool falls
+    // back to generating inline. Returns true if the pool served the key.
+    bool generateNewKeypair(KeypairPool& pool, bool blocking = false);
+
+    // Use record 'index' of 'store' (same scheme as this wallet). The
+    // public key is copied; the secret key stays in the mapping and is
+    // signed from in place, so the wallet keeps 'store' alive.
+    void bindKeystoreEntry(std::shared_ptr<const Keystore> store, size_t index);
+
     const std::vector<uint8_t>& publicKey() const { return pk_; }
+    // Empty while bound to a keystore entry.
     const std::vector<uint8_t>& secretKey() const { return sk_; }
 
-    // Create and sign a transaction from this wallet to 'to_pubkey'
+    // What createTransaction signs (default: the full body).
+    void setSigMode(TxSigMode mode) { sig_mode_ = mode; }
+    TxSigMode sigMode() const { return sig_mode_; }
+
+    // Create and sign a transaction from this wallet to 'to_pubkey'.
+    // The returned tx carries its cached encoding and id.
     Transaction createTransaction(const std::vector<uint8_t>& to_pubkey,
                                   uint64_t amount,
                                   uint64_t nonce) const;
 
 private:
+    void setKeypair(std::vector<uint8_t> pk, std::vector<uint8_t> sk);
+
     std::shared_ptr<Crypto> crypto_;
     std::vector<uint8_t> pk_;
     std::vector<uint8_t> sk_;
+    std::shared_ptr<const PreparedKey> prepared_; // sk_ expanded for signing
+    std::shared_ptr<const Keystore> keystore_;    // set while bound
+    KeystoreEntry bound_;
+    TxSigMode sig_mode_ = TxSigMode::BODY;
 };
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "algo_config.h"
+#include "crypto.h"
+#include "transaction.h"
+
+enum class AccountDistribution {
+    UNIFORM,
+    ZIPF
+};
+
+struct WorkloadConfig {
+    uint64_t seed = 42;
+    size_t account_count = 100;
+    size_t block_count = 10;
+    size_t tx_per_block = 100;
+    AccountDistribution sender_dist = AccountDistribution::UNIFORM;
+    AccountDistribution receiver_dist = AccountDistribution::UNIFORM;
+    double zipf_s = 1.0;          // exponent for ZIPF (rank k has weight 1/k^s)
+    uint64_t max_amount = 1000;   // amounts are uniform in [1, max_amount]
+};
+
+// A pre-signed transaction stream over many accounts.
+// Account selection, amounts and nonces are fully determined by the
+// config's seed. Keys and signatures come from randomness.h and repeat
+// only in its DETERMINISTIC mode; otherwise save the workload and replay
+// it when runs must use identical data.
+struct Workload {
+    WorkloadConfig config;
+    SchemeId scheme = SchemeId::NONE;
+    std::vector<std::vector<uint8_t>> account_pubkeys;
+    std::vector<std::vector<Transaction>> blocks; // signed txs, one entry per block
+};
+
+// Creates config.account_count wallets on 'crypto' and signs every tx.
+// Senders never pay themselves; each sender's nonces count up from 1.
+Workload generateWorkload(const WorkloadConfig& cfg, std::shared_ptr<Crypto> crypto);
+
+// Binary format: accounts are written once and txs refer to them by index,
+// so a file is much smaller than the blocks it expands to. Throws
+// std::runtime_error on I/O errors or a malformed file.
+void saveWorkload(const std::string& path, const Workload& workload);
+Workload loadWorkload(const std::string& path);
+
+const char* distributionName(AccountDistribution d);
@@ -1,4 +1,5 @@
 #include "algo_config.h"
+#include <stdexcept>
 
 // CHANGE THIS TO SWITCH ALGORITHMS
     // return {AlgoFamily::ML_DSA, "44"};
@@ -12,3 +13,48 @@
 AlgoConfig getSelectedAlgorithm() {
     return {AlgoFamily::FALCON, "512"};
 }
+
+SchemeId schemeIdFor(const AlgoConfig& cfg) {
+    switch (cfg.family) {
+    case AlgoFamily::ML_DSA:
+        if (cfg.variant == "44") return SchemeId::ML_DSA_44;
+        if (cfg.variant == "65") return SchemeId::ML_DSA_65;
+        if (cfg.variant == "87") return SchemeId::ML_DSA_87;
+        break;
+    case AlgoFamily::FALCON:
+        if (cfg.variant == "512")  return SchemeId::FALCON_512;
+        if (cfg.variant == "1024") return SchemeId::FALCON_1024;
+        break;
+    case AlgoFamily::HAWK:
+        if (cfg.variant == "512")  return SchemeId::HAWK_512;
+        if (cfg.variant == "1024") return SchemeId::HAWK_1024;
+        break;
+    }
+    throw std::runtime_error("No scheme id for variant: " + cfg.variant);
+}
+
+AlgoConfig algoConfigFor(SchemeId id) {
+    switch (id) {
+    case SchemeId::ML_DSA_44:   return {AlgoFamily::ML_DSA, "44"};
+    case SchemeId::ML_DSA_65:   return {AlgoFamily::ML_DSA, "65"};
+    case SchemeId::ML_DSA_87:   return {AlgoFamily::ML_DSA, "87"};
+    case SchemeId::FALCON_512:  return {AlgoFamily::FALCON, "512"};
+    case SchemeId::FALCON_1024: return {AlgoFamily::FALCON, "1024"};
+    case SchemeId::HAWK_512:    return {AlgoFamily::HAWK, "512"};
+    case SchemeId::HAWK_1024:   return {AlgoFamily::HAWK, "1024"};
+    default:
+        throw std::runtime_error("Unknown scheme id in algoConfigFor");
+    }
+}
+
+std::vector<AlgoConfig> allAlgorithms() {
+    return {
+        {AlgoFamily::ML_DSA, "44"},
+        {AlgoFamily::ML_DSA, "65"},
+        {AlgoFamily::ML_DSA, "87"},
+        {AlgoFamily::FALCON, "512"},
+        {AlgoFamily::FALCON, "1024"},
+        {AlgoFamily::HAWK, "512"},
+        {AlgoFamily::HAWK, "1024"},
+    };
+}
@@ -1,59 +1,289 @@
 #include "block.h"
 #include "block_utils.h"
+#include <unordered_set>
 
-std::vector<uint8_t> serializeBlockForHash(const Block& block) {
-    std::vector<uint8_t> out;
+template <typename Writer>
+static void encodeHeaderFields(Writer& w, const Block& block) {
+    w.u32(block.index);
+    w.raw(block.prev_hash); // 32 bytes
+    w.u64(block.timestamp);
+}
 
-    appendUint32(out, block.index);
-    // prev_hash (32 bytes)
-    out.insert(out.end(), block.prev_hash.begin(), block.prev_hash.end());
-    appendUint64(out, block.timestamp);
+template <typename Writer>
+static void encodeTxBodies(Writer& w, const std::vector<Transaction>& txs) {
+    w.u64(static_cast<uint64_t>(txs.size()));
+    for (const auto& tx : txs) {
+        // body length + body, written in place (no per-tx temporary).
+        // Always from the fields: what is hashed and stored must be what
+        // the block holds, whatever tx.encoding says.
+        w.u64(static_cast<uint64_t>(txBodySize(tx)));
+        encodeTxBody(w, tx);
+    }
+}
 
-    // Transactions
-    appendUint64(out, static_cast<uint64_t>(block.transactions.size()));
-    for (const auto& tx : block.transactions) {
-        // We include BOTH body and signature in the hash,
-        // so changing any detail will change block_hash.
-        std::vector<uint8_t> body = serializeTxForSigning(tx);
+template <typename Writer>
+static void encodeWitness(Writer& w, const std::vector<Transaction>& txs) {
+    w.u64(static_cast<uint64_t>(txs.size()));
+    for (const auto& tx : txs) {
+        w.bytes(tx.signature); // signature length + signature
+    }
+}
+
+// What block_hash covers. Transactions enter only through body_root and
+// witness_root, so the header can be checked on its own.
+template <typename Writer>
+static void encodeHeaderForHash(Writer& w, const BlockHeader& h) {
+    w.u32(h.index);
+    w.raw(h.prev_hash);
+    w.u64(h.timestamp);
+    w.raw(h.body_root);
+    w.raw(h.witness_root);
+}
+
+template <typename Writer>
+void encodeBlockHeader(Writer& w, const BlockHeader& header) {
+    encodeHeaderForHash(w, header);
+    w.raw(header.block_hash);
+}
+
+template <typename Writer>
+void encodeBlockWitness(Writer& w, const Block& block) {
+    encodeWitness(w, block.transactions);
+}
+
+template <typename Writer>
+void encodeBlockBody(Writer& w, const Block& block) {
+    encodeTxBodies(w, block.transactions);
+    w.u8(block.witness_pruned ? 0 : 1);
+    if (!block.witness_pruned) {
+        encodeWitness(w, block.transactions);
+    }
+}
+
+template <typename Writer>
+void encodeBlockBase(Writer& w, const Block& block) {
+    encodeHeaderFields(w, block);
+
+    // block_hash itself + witness commitment
+    w.raw(block.block_hash);
+    w.raw(block.witness_root);
 
-        // body length + body
-        appendUint64(out, static_cast<uint64_t>(body.size()));
-        out.insert(out.end(), body.begin(), body.end());
+    encodeTxBodies(w, block.transactions);
+}
+
+template <typename Writer>
+void encodeFullBlock(Writer& w, const Block& block) {
+    encodeHeaderFields(w, block);
+    w.raw(block.block_hash);
+    w.raw(block.witness_root);
+    encodeBlockBody(w, block);
+}
+
+#define PQBC_INSTANTIATE_BLOCK_ENCODERS(Sink)                                   \
+    template void encodeBlockWitness(ByteWriter<Sink>&, const Block&);         \
+    template void encodeBlockBase(ByteWriter<Sink>&, const Block&);            \
+    template void encodeFullBlock(ByteWriter<Sink>&, const Block&);            \
+    template void encodeBlockBody(ByteWriter<Sink>&, const Block&);            \
+    template void encodeBlockHeader(ByteWriter<Sink>&, const BlockHeader&);
+PQBC_INSTANTIATE_BLOCK_ENCODERS(SizeSink)
+PQBC_INSTANTIATE_BLOCK_ENCODERS(BufferSink)
+PQBC_INSTANTIATE_BLOCK_ENCODERS(HashSink)
+PQBC_INSTANTIATE_BLOCK_ENCODERS(FileSink)
+#undef PQBC_INSTANTIATE_BLOCK_ENCODERS
+
+size_t fullBlockSize(const Block& block) {
+    SizeSink size;
+    ByteWriter<SizeSink> w(size);
+    encodeFullBlock(w, block);
+    return size.size();
+}
+
+std::array<uint8_t, 32> computeBodyRoot(const std::vector<Transaction>& txs) {
+    return encodeToHash([&](auto& w) { encodeTxBodies(w, txs); });
+}
+
+BlockHeader blockHeaderOf(const Block& block) {
+    BlockHeader h;
+    h.index = block.index;
+    h.prev_hash = block.prev_hash;
+    h.timestamp = block.timestamp;
+    h.body_root = computeBodyRoot(block.transactions);
+    h.witness_root = block.witness_root;
+    h.block_hash = block.block_hash;
+    return h;
+}
+
+Block assembleBlock(const BlockHeader& header, BlockBody body) {
+    Block b;
+    b.index = header.index;
+    b.prev_hash = header.prev_hash;
+    b.timestamp = header.timestamp;
+    b.transactions = std::move(body.transactions);
+    b.witness_root = header.witness_root;
+    b.block_hash = header.block_hash;
+    b.witness_pruned = body.witness_pruned;
+    return b;
+}
 
-        // signature length + signature
-        appendUint64(out, static_cast<uint64_t>(tx.signature.size()));
-        out.insert(out.end(), tx.signature.begin(), tx.signature.end());
+bool bodyMatchesHeader(const BlockHeader& header, const BlockBody& body) {
+    if (computeBodyRoot(body.transactions) != header.body_root) {
+        return false;
     }
+    return body.witness_pruned ||
+           encodeToHash([&](auto& w) { encodeWitness(w, body.transactions); }) == header.witness_root;
+}
 
+std::vector<uint8_t> serializeBlockForHash(const Block& block) {
+    BlockHeader h = blockHeaderOf(block);
+    std::vector<uint8_t> out =
+        encodeToVector([&](auto& w) { encodeHeaderForHash(w, h); });
+    countSerializedBytes(out.size());
     return out;
 }
 
+std::array<uint8_t, 32> computeHeaderHash(const BlockHeader& header) {
+    return encodeToHash([&](auto& w) { encodeHeaderForHash(w, header); });
+}
+
 std::array<uint8_t, 32> computeBlockHash(const Block& block) {
-    auto payload = serializeBlockForHash(block);
-    return simpleHash32(payload);
+    return computeHeaderHash(blockHeaderOf(block));
 }
 
-std::vector<uint8_t> serializeFullBlock(const Block& block) {
-    std::vector<uint8_t> out;
+std::vector<uint8_t> serializeBlockHeader(const BlockHeader& header) {
+    std::vector<uint8_t> out =
+        encodeToVector([&](auto& w) { encodeBlockHeader(w, header); });
+    countSerializedBytes(out.size());
+    return out;
+}
 
-    appendUint32(out, block.index);
-    out.insert(out.end(), block.prev_hash.begin(), block.prev_hash.end());
-    appendUint64(out, block.timestamp);
+BlockHeader deserializeBlockHeader(const uint8_t* data, size_t size) {
+    ByteReader r(data, size, "deserializeBlockHeader");
+    if (size != BLOCK_HEADER_SIZE) {
+        r.fail("bad header size");
+    }
+    BlockHeader h;
+    h.index = r.u32();
+    r.raw(h.prev_hash);
+    h.timestamp = r.u64();
+    r.raw(h.body_root);
+    r.raw(h.witness_root);
+    r.raw(h.block_hash);
+    return h;
+}
 
-    // block_hash itself
-    out.insert(out.end(), block.block_hash.begin(), block.block_hash.end());
+std::vector<uint8_t> serializeBlockWitness(const Block& block) {
+    std::vector<uint8_t> out =
+        encodeToVector([&](auto& w) { encodeBlockWitness(w, block); });
+    countSerializedBytes(out.size());
+    return out;
+}
 
-    // Transactions (same encoding as in serializeBlockForHash)
-    appendUint64(out, static_cast<uint64_t>(block.transactions.size()));
-    for (const auto& tx : block.transactions) {
-        std::vector<uint8_t> body = serializeTxForSigning(tx);
+std::array<uint8_t, 32> computeWitnessRoot(const Block& block) {
+    return encodeToHash([&](auto& w) { encodeBlockWitness(w, block); });
+}
+
+std::vector<uint8_t> serializeBlockBase(const Block& block) {
+    std::vector<uint8_t> out =
+        encodeToVector([&](auto& w) { encodeBlockBase(w, block); });
+    countSerializedBytes(out.size());
+    return out;
+}
 
-        appendUint64(out, static_cast<uint64_t>(body.size()));
-        out.insert(out.end(), body.begin(), body.end());
+std::vector<uint8_t> serializeFullBlock(const Block& block) {
+    std::vector<uint8_t> out =
+        encodeToVector([&](auto& w) { encodeFullBlock(w, block); });
+    countSerializedBytes(out.size());
+    return out;
+}
 
-        appendUint64(out, static_cast<uint64_t>(tx.signature.size()));
-        out.insert(out.end(), tx.signature.begin(), tx.signature.end());
+BlockBody decodeBlockBody(ByteReader& r) {
+    BlockBody out;
+    uint64_t tx_count = r.u64();
+    // Every body is at least 8 (length) + 33 bytes; don't let a bogus
+    // count reserve gigabytes.
+    if (tx_count > r.remaining() / 41) {
+        r.fail("bad tx count");
+    }
+    out.transactions.resize(static_cast<size_t>(tx_count));
+    for (auto& tx : out.transactions) {
+        ByteReader body = r.sub(r.u64());
+        setTxSchemeTag(tx, body.u8());
+        tx.from_pubkey = body.bytes();
+        tx.to_pubkey = body.bytes();
+        tx.amount = body.u64();
+        tx.nonce = body.u64();
+        if (!body.done()) {
+            r.fail("bad tx body length");
+        }
+    }
+
+    uint8_t has_witness = r.u8();
+    if (has_witness > 1) {
+        r.fail("bad witness flag");
+    }
+    out.witness_pruned = (has_witness == 0);
+    if (has_witness) {
+        if (r.u64() != tx_count) {
+            r.fail("witness count mismatch");
+        }
+        for (auto& tx : out.transactions) {
+            tx.signature = r.bytes();
+        }
     }
 
     return out;
 }
+
+Block deserializeFullBlock(const std::vector<uint8_t>& data) {
+    ByteReader r(data, "deserializeFullBlock");
+    Block block;
+
+    block.index = r.u32();
+    r.raw(block.prev_hash);
+    block.timestamp = r.u64();
+    r.raw(block.block_hash);
+    r.raw(block.witness_root);
+
+    BlockBody body = decodeBlockBody(r);
+    block.transactions = std::move(body.transactions);
+    block.witness_pruned = body.witness_pruned;
+
+    if (!r.done()) {
+        r.fail("trailing bytes");
+    }
+    return block;
+}
+
+void pruneBlockWitness(Block& block) {
+    for (auto& tx : block.transactions) {
+        std::vector<uint8_t>().swap(tx.signature); // release capacity too
+    }
+    block.witness_pruned = true;
+    dropTxEncodings(block);
+}
+
+void dropTxEncodings(Block& block) {
+    for (auto& tx : block.transactions) {
+        clearTxEncoding(tx);
+    }
+}
+
+size_t blockMemoryFootprint(const Block& block) {
+    size_t total = sizeof(Block);
+    total += block.transactions.capacity() * sizeof(Transaction);
+    for (const auto& tx : block.transactions) {
+        total += tx.from_pubkey.capacity();
+        total += tx.to_pubkey.capacity();
+        total += tx.signature.capacity();
+    }
+    // Cached encodings (a full body copy each), once per shared object.
+    std::unordered_set<const TxEncoding*> seen;
+    for (const auto& tx : block.transactions) {
+        const TxEncoding* enc = tx.encoding.get();
+        if (enc && seen.insert(enc).second) {
+            total += sizeof(TxEncoding) + 2 * sizeof(void*); // + shared_ptr control block
+            total += enc->body.capacity() + enc->digest_msg.capacity();
+        }
+    }
+    return total;
+}
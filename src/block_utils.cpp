@@ -1,20 +1,21 @@
 #include "block_utils.h"
+#include "metrics.h"
 #include <oqs/sha3.h> 
 
-void appendUint32(std::vector<uint8_t>& out, uint32_t v) {
-    out.push_back(static_cast<uint8_t>(v & 0xFF));
-    out.push_back(static_cast<uint8_t>((v >> 8) & 0xFF));
-    out.push_back(static_cast<uint8_t>((v >> 16) & 0xFF));
-    out.push_back(static_cast<uint8_t>((v >> 24) & 0xFF));
-}
-
-void appendUint64(std::vector<uint8_t>& out, uint64_t v) {
-    for (int i = 0; i < 8; ++i) {
-        out.push_back(static_cast<uint8_t>((v >> (8 * i)) & 0xFF));
-    }
+void countSerializedBytes(size_t n) {
+    static Counter& serialized =
+        metrics().counter("pqbc_serialized_bytes_total", "Bytes produced by tx/block serializers");
+    serialized.inc(n);
 }
 
 std::array<uint8_t, 32> simpleHash32(const std::vector<uint8_t>& data) {
+    static Histogram& hash_latency =
+        metrics().histogram("pqbc_hash_seconds", "SHA3-256 latency (simpleHash32)");
+    static Counter& hashed_bytes =
+        metrics().counter("pqbc_hashed_bytes_total", "Bytes fed to simpleHash32");
+    ScopedLatency timer(hash_latency);
+    hashed_bytes.inc(data.size());
+
     std::array<uint8_t, 32> out{};
 
     // SHA3-256 from liboqs
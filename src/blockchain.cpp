@@ -1,18 +1,25 @@
 #include "blockchain.h"
 #include "block_utils.h"
+#include "metrics.h"
 #include "transaction.h"
 
-Blockchain::Blockchain(std::shared_ptr<Crypto> crypto)
-    : crypto_(std::move(crypto)) {
+Blockchain::Blockchain(std::shared_ptr<Crypto> crypto) {
+    registry_.add(std::move(crypto));
     chain_.push_back(makeGenesisBlock());
 }
 
-Block Blockchain::makeGenesisBlock() const {
+Blockchain::Blockchain(CryptoRegistry registry)
+    : registry_(std::move(registry)) {
+    chain_.push_back(makeGenesisBlock());
+}
+
+Block makeGenesisBlock() {
     Block g;
     g.index = 0;
     // prev_hash stays all-zero
     g.timestamp = 0; // hardcoded
     g.transactions.clear();
+    g.witness_root = computeWitnessRoot(g);
     g.block_hash = computeBlockHash(g);
     return g;
 }
@@ -25,6 +32,7 @@ Block Blockchain::createBlockWithTransactions(const std::vector<Transaction>& tx
     b.timestamp = static_cast<uint64_t>(b.index);
 
     b.transactions = txs;
+    b.witness_root = computeWitnessRoot(b);
     b.block_hash = computeBlockHash(b);
 
     // We do NOT automatically push it into chain here,
@@ -32,29 +40,200 @@ Block Blockchain::createBlockWithTransactions(const std::vector<Transaction>& tx
     return b;
 }
 
+namespace {
+struct ChainMetrics {
+    Counter& validated = metrics().counter("pqbc_blocks_validated_total", "Blocks that passed validateBlock");
+    Counter& rejected = metrics().counter("pqbc_blocks_rejected_total", "Blocks that failed validateBlock");
+    Histogram& validate = metrics().histogram("pqbc_block_validate_seconds", "validateBlock latency");
+    Gauge& height = metrics().gauge("pqbc_chain_height", "Index of the latest appended block");
+};
+
+ChainMetrics& chainMetrics() {
+    static ChainMetrics m;
+    return m;
+}
+} // namespace
+
+static bool validateBlockImpl(const Block& tip, const CryptoRegistry& registry,
+                              const Block& block) {
+    // 1. Check linkage + 2. Check block hash
+    if (!checkLinkageAndHash(tip, block)) {
+        return false;
+    }
+
+    // 3. Check the witness is present and matches its commitment
+    if (block.witness_pruned || !checkWitness(block)) {
+        return false;
+    }
+
+    // 4. Check all transaction signatures
+    return verifyBlockSignatures(registry, block);
+}
+
 bool Blockchain::validateBlock(const Block& block) const {
-    // 1. Check linkage
-    if (block.index != latestBlock().index + 1) {
+    ChainMetrics& m = chainMetrics();
+    ScopedLatency timer(m.validate);
+    bool ok = validateBlockImpl(latestBlock(), registry_, block);
+    (ok ? m.validated : m.rejected).inc();
+    return ok;
+}
+
+bool Blockchain::appendBlock(const Block& block) {
+    if (!validateBlock(block)) {
         return false;
     }
-    if (block.prev_hash != latestBlock().block_hash) {
+    chain_.push_back(block);
+    dropTxEncodings(chain_.back());
+    pruneOldWitnesses();
+    chainMetrics().height.set(latestBlock().index);
+    return true;
+}
+
+bool Blockchain::appendPreverifiedBlock(Block block) {
+    ChainMetrics& m = chainMetrics();
+    if (!checkLinkageAndHash(latestBlock(), block) ||
+        block.witness_pruned || !checkWitness(block)) {
+        m.rejected.inc();
+        return false;
+    }
+    m.validated.inc();
+    chain_.push_back(std::move(block));
+    dropTxEncodings(chain_.back());
+    pruneOldWitnesses();
+    m.height.set(latestBlock().index);
+    return true;
+}
+
+void Blockchain::setAssumeValid(const AssumeValidCheckpoint& cp) {
+    assume_valid_ = cp;
+    has_assume_valid_ = true;
+}
+
+SyncResult Blockchain::syncBlocks(const std::vector<Block>& blocks) {
+    SyncResult res;
+    size_t next = 0;
+
+    if (has_assume_valid_) {
+        // Header-only pass from our tip up to the checkpoint height.
+        // Nothing is appended unless the checkpoint hash matches, so a bad
+        // checkpoint can never let an unverified block in.
+        const Block* prev = &latestBlock();
+        size_t anchor = blocks.size();
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            const Block& b = blocks[i];
+            if (b.index > assume_valid_.height) {
+                break;
+            }
+            if (!checkLinkageAndHash(*prev, b) || !checkWitness(b)) {
+                break;
+            }
+            if (b.index == assume_valid_.height) {
+                if (b.block_hash == assume_valid_.block_hash) {
+                    anchor = i;
+                }
+                break;
+            }
+            prev = &b;
+        }
+
+        if (anchor < blocks.size()) {
+            size_t first = chain_.size();
+            chain_.insert(chain_.end(), blocks.begin(), blocks.begin() + anchor + 1);
+            for (size_t i = first; i < chain_.size(); ++i) {
+                dropTxEncodings(chain_[i]);
+            }
+            pruneOldWitnesses();
+            next = anchor + 1;
+            res.appended = next;
+            res.sig_checks_skipped = next;
+            res.checkpoint_used = true;
+            chainMetrics().height.set(latestBlock().index);
+        }
+    }
+
+    for (; next < blocks.size(); ++next) {
+        if (!appendBlock(blocks[next])) {
+            break;
+        }
+        ++res.appended;
+    }
+
+    return res;
+}
+
+void Blockchain::setWitnessPruneDepth(size_t depth) {
+    witness_prune_depth_ = depth;
+    pruneOldWitnesses();
+}
+
+void Blockchain::pruneOldWitnesses() {
+    if (witness_prune_depth_ == 0 || chain_.size() <= witness_prune_depth_) {
+        return;
+    }
+    size_t end = chain_.size() - witness_prune_depth_;
+    for (; first_unpruned_ < end; ++first_unpruned_) {
+        if (!chain_[first_unpruned_].witness_pruned) {
+            pruneBlockWitness(chain_[first_unpruned_]);
+        }
+    }
+}
+
+bool checkLinkageAndHash(const Block& prev, const Block& block) {
+    if (block.index != prev.index + 1) {
+        return false;
+    }
+    if (block.prev_hash != prev.block_hash) {
         return false;
     }
 
-    // 2. Check block hash
     auto recomputed = computeBlockHash(block);
     if (recomputed != block.block_hash) {
         return false;
     }
+    return true;
+}
+
+bool verifyBlockSignatures(const CryptoRegistry& registry, const Block& block) {
+    const auto& txs = block.transactions;
+
+    // Messages must outlive the VerifyItems that point at them. Txs whose
+    // cached encoding still matches their fields are verified against it
+    // directly; a stale cache (a mutated copy) is re-encoded.
+    std::vector<std::vector<uint8_t>> msgs(txs.size());
+    std::vector<std::vector<VerifyItem>> groups(SCHEME_ID_COUNT);
+
+    for (size_t i = 0; i < txs.size(); ++i) {
+        const Transaction& tx = txs[i];
+        if (!registry.contains(tx.scheme)) {
+            return false;
+        }
+        const std::vector<uint8_t>* msg;
+        if (const TxEncoding* enc = cachedTxEncoding(tx)) {
+            msg = &enc->message();
+        } else {
+            msgs[i] = txSigningMessage(tx);
+            msg = &msgs[i];
+        }
+        groups[static_cast<size_t>(tx.scheme)].push_back(
+            {msg, &tx.signature, &tx.from_pubkey});
+    }
 
-    // 3. Check all transaction signatures
-    for (const auto& tx : block.transactions) {
-        std::vector<uint8_t> msg = serializeTxForSigning(tx);
-        bool ok = crypto_->verify(msg, tx.signature, tx.from_pubkey);
-        if (!ok) {
+    for (size_t s = 0; s < groups.size(); ++s) {
+        if (groups[s].empty()) {
+            continue;
+        }
+        auto crypto = registry.get(static_cast<SchemeId>(s));
+        if (!crypto->verifyBatch(groups[s])) {
             return false;
         }
     }
 
     return true;
 }
+
+bool checkWitness(const Block& block) {
+    if (block.witness_pruned) {
+        return true;
+    }
+    return computeWitnessRoot(block) == block.witness_root;
+}
@@ -0,0 +1,122 @@
+#include "body_store.h"
+#include <stdexcept>
+
+static const uint32_t BODY_STORE_MAGIC   = 0x53425150u; // "PQBS" little-endian
+static const uint32_t BODY_STORE_VERSION = 1;
+static const size_t HEADER_LEN = 8;
+static const size_t TRAILER_LEN = 16;
+
+// ---------------- Writer ----------------
+
+BodyStoreWriter::BodyStoreWriter(const std::string& path)
+    : path_(path),
+      file_(path, std::ios::binary | std::ios::trunc),
+      sink_(file_),
+      w_(sink_) {
+    if (!file_) {
+        throw std::runtime_error("BodyStoreWriter: cannot open " + path);
+    }
+    w_.u32(BODY_STORE_MAGIC);
+    w_.u32(BODY_STORE_VERSION);
+    offsets_.push_back(HEADER_LEN);
+}
+
+void BodyStoreWriter::add(const Block& block) {
+    if (finished_) {
+        throw std::runtime_error("BodyStoreWriter: add after finish");
+    }
+    if (block.index != count()) {
+        throw std::runtime_error("BodyStoreWriter: bodies must be added in height order");
+    }
+    SizeSink size;
+    ByteWriter<SizeSink> sizer(size);
+    encodeBlockBody(sizer, block);
+    encodeBlockBody(w_, block); // streamed, no per-block buffer
+    offsets_.push_back(offsets_.back() + size.size());
+}
+
+void BodyStoreWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    uint64_t table_at = offsets_.back();
+    for (uint64_t off : offsets_) {
+        w_.u64(off);
+    }
+    w_.u64(count());
+    w_.u64(table_at);
+    finished_ = true;
+    try {
+        sink_.flush();
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("BodyStoreWriter: write failed for " + path_);
+    }
+}
+
+// ---------------- Reader ----------------
+
+std::shared_ptr<const BodyStore> BodyStore::open(const std::string& path) {
+    return std::shared_ptr<const BodyStore>(new BodyStore(MappedFile::openReadOnly(path), path));
+}
+
+BodyStore::BodyStore(MappedFile file, const std::string& path)
+    : file_(std::move(file)) {
+    const std::string context = "BodyStore '" + path + "'";
+    const size_t size = file_.size();
+    if (size < HEADER_LEN + 8 + TRAILER_LEN) {
+        throw std::runtime_error(context + ": truncated file");
+    }
+    ByteReader h(file_.data(), HEADER_LEN, context.c_str());
+    if (h.u32() != BODY_STORE_MAGIC) {
+        h.fail("bad magic");
+    }
+    if (h.u32() != BODY_STORE_VERSION) {
+        h.fail("unsupported version");
+    }
+
+    ByteReader t(file_.data() + size - TRAILER_LEN, TRAILER_LEN, context.c_str());
+    uint64_t count = t.u64();
+    uint64_t table_at = t.u64();
+    if (table_at < HEADER_LEN || table_at > size - TRAILER_LEN) {
+        t.fail("bad offsets table");
+    }
+    uint64_t table_len = size - TRAILER_LEN - table_at;
+    if (table_len < 8 || table_len % 8 != 0 || table_len / 8 - 1 != count) {
+        t.fail("bad offsets table");
+    }
+    count_ = static_cast<size_t>(count);
+    offsets_ = file_.data() + table_at;
+
+    // Offsets must be increasing and stay inside the bodies section, so
+    // load() can trust them.
+    if (offset(0) != HEADER_LEN || offset(count_) != table_at) {
+        t.fail("bad offsets table");
+    }
+    for (size_t i = 0; i < count_; ++i) {
+        if (offset(i + 1) < offset(i)) {
+            t.fail("bad offsets table");
+        }
+    }
+}
+
+uint64_t BodyStore::offset(size_t i) const {
+    ByteReader r(offsets_ + 8 * i, 8, "BodyStore");
+    return r.u64();
+}
+
+size_t BodyStore::bodySize(uint32_t height) const {
+    if (height >= count_) {
+        throw std::runtime_error("BodyStore: height out of range");
+    }
+    return static_cast<size_t>(offset(height + 1) - offset(height));
+}
+
+BlockBody BodyStore::load(uint32_t height) const {
+    size_t len = bodySize(height);
+    ByteReader r(file_.data() + offset(height), len, "BodyStore::load");
+    BlockBody body = decodeBlockBody(r);
+    if (!r.done()) {
+        r.fail("trailing bytes");
+    }
+    return body;
+}
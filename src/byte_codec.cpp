@@ -0,0 +1,98 @@
+#include "byte_codec.h"
+#include "metrics.h"
+#include <ostream>
+#include <string>
+
+namespace {
+struct HashMetrics {
+    Histogram& latency = metrics().histogram("pqbc_hash_seconds", "SHA3-256 latency (simpleHash32)");
+    Counter& bytes = metrics().counter("pqbc_hashed_bytes_total", "Bytes fed to simpleHash32");
+};
+
+HashMetrics& hashMetrics() {
+    static HashMetrics m;
+    return m;
+}
+} // namespace
+
+HashSink::HashSink()
+    : start_ns_(metricsEnabled() ? metricsNowNanos() : 0) {
+    OQS_SHA3_sha3_256_inc_init(&ctx_);
+}
+
+HashSink::~HashSink() {
+    if (!finished_) {
+        OQS_SHA3_sha3_256_inc_ctx_release(&ctx_);
+    }
+}
+
+void HashSink::flush() {
+    if (staged_) {
+        OQS_SHA3_sha3_256_inc_absorb(&ctx_, stage_.data(), staged_);
+        staged_ = 0;
+    }
+}
+
+void HashSink::put(const uint8_t* src, size_t n) {
+    total_ += n;
+    if (staged_ + n <= stage_.size()) {
+        std::memcpy(stage_.data() + staged_, src, n);
+        staged_ += n;
+        return;
+    }
+    flush();
+    if (n >= stage_.size()) {
+        OQS_SHA3_sha3_256_inc_absorb(&ctx_, src, n);
+    } else {
+        std::memcpy(stage_.data(), src, n);
+        staged_ = n;
+    }
+}
+
+std::array<uint8_t, 32> HashSink::finish() {
+    if (finished_) {
+        throw std::runtime_error("HashSink: finish called twice");
+    }
+    flush();
+    std::array<uint8_t, 32> out{};
+    OQS_SHA3_sha3_256_inc_finalize(out.data(), &ctx_);
+    OQS_SHA3_sha3_256_inc_ctx_release(&ctx_);
+    finished_ = true;
+
+    HashMetrics& m = hashMetrics();
+    m.bytes.inc(total_);
+    if (start_ns_) {
+        m.latency.observeNanos(metricsNowNanos() - start_ns_);
+    }
+    return out;
+}
+
+void FileSink::put(const uint8_t* src, size_t n) {
+    if (used_ + n > buf_.size()) {
+        drain();
+    }
+    if (n >= buf_.size()) {
+        os_.write(reinterpret_cast<const char*>(src), static_cast<std::streamsize>(n));
+        return;
+    }
+    std::memcpy(buf_.data() + used_, src, n);
+    used_ += n;
+}
+
+void FileSink::drain() {
+    if (used_) {
+        os_.write(reinterpret_cast<const char*>(buf_.data()), static_cast<std::streamsize>(used_));
+        used_ = 0;
+    }
+}
+
+void FileSink::flush() {
+    drain();
+    if (!os_) {
+        throw std::runtime_error("FileSink: write failed");
+    }
+}
+
+void ByteReader::fail(const char* what) const {
+    throw std::runtime_error(std::string(context_) + ": " + what);
+}
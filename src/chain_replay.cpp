@@ -0,0 +1,162 @@
+#include "chain_replay.h"
+#include "byte_codec.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <stdexcept>
+
+static const uint32_t CHAIN_FILE_MAGIC   = 0x48435150u; // "PQCH" little-endian
+static const uint32_t CHAIN_FILE_VERSION = 2; // 2: block_hash covers body_root
+
+namespace {
+// Output of the parallel stage for one block.
+struct DecodedBlock {
+    Block block;
+    bool sigs_ok = false; // decoded, witness present, every signature valid
+};
+
+DecodedBlock decodeAndVerify(const CryptoRegistry& registry,
+                             const std::vector<uint8_t>& data) {
+    DecodedBlock d;
+    try {
+        d.block = deserializeFullBlock(data);
+    } catch (const std::runtime_error&) {
+        return d;
+    }
+    d.sigs_ok = !d.block.witness_pruned && verifyBlockSignatures(registry, d.block);
+    return d;
+}
+} // namespace
+
+static ReplayResult replaySequential(Blockchain& chain,
+                                     const std::vector<std::vector<uint8_t>>& in) {
+    ReplayResult res;
+    for (size_t i = 0; i < in.size(); ++i) {
+        Block block;
+        try {
+            block = deserializeFullBlock(in[i]);
+        } catch (const std::runtime_error&) {
+            res.ok = false;
+        }
+        if (!res.ok || !chain.appendBlock(block)) {
+            res.ok = false;
+            res.failed_at = i;
+            break;
+        }
+        ++res.blocks;
+        res.txs += block.transactions.size();
+    }
+    return res;
+}
+
+static ReplayResult replayPipelined(Blockchain& chain,
+                                    const std::vector<std::vector<uint8_t>>& in,
+                                    unsigned threads, size_t window) {
+    ReplayResult res;
+    const CryptoRegistry& registry = chain.registry();
+    ThreadPool pool(threads);
+    std::deque<std::future<DecodedBlock>> pending;
+
+    size_t next_submit = 0;
+    auto submitUpTo = [&](size_t limit) {
+        for (; next_submit < in.size() && next_submit < limit; ++next_submit) {
+            const std::vector<uint8_t>* data = &in[next_submit];
+            pending.push_back(pool.submit([&registry, data] {
+                return decodeAndVerify(registry, *data);
+            }));
+        }
+    };
+
+    submitUpTo(window);
+    for (size_t i = 0; i < in.size(); ++i) {
+        DecodedBlock d = pending.front().get();
+        pending.pop_front();
+        submitUpTo(i + 1 + window);
+
+        size_t tx_count = d.block.transactions.size();
+        if (!d.sigs_ok || !chain.appendPreverifiedBlock(std::move(d.block))) {
+            res.ok = false;
+            res.failed_at = i;
+            break;
+        }
+        ++res.blocks;
+        res.txs += tx_count;
+    }
+
+    // Tasks still in flight only read 'in' and the registry; let them
+    // finish before either can go away.
+    for (auto& f : pending) {
+        f.wait();
+    }
+    return res;
+}
+
+ReplayResult replayChain(Blockchain& chain,
+                         const std::vector<std::vector<uint8_t>>& serialized_blocks,
+                         unsigned threads, size_t window) {
+    if (window == 0) {
+        window = 4 * static_cast<size_t>(threads ? threads : 1);
+    }
+
+    uint64_t t1 = nowMicros();
+    ReplayResult res = threads == 0
+        ? replaySequential(chain, serialized_blocks)
+        : replayPipelined(chain, serialized_blocks, threads, window);
+    res.elapsed_us = nowMicros() - t1;
+    return res;
+}
+
+// ---------------- Chain file ----------------
+
+void saveChainFile(const std::string& path, const std::vector<Block>& blocks) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        throw std::runtime_error("saveChainFile: cannot open " + path);
+    }
+    FileSink sink(f);
+    ByteWriter<FileSink> w(sink);
+
+    w.u32(CHAIN_FILE_MAGIC);
+    w.u32(CHAIN_FILE_VERSION);
+    w.u64(blocks.size());
+    for (const auto& b : blocks) {
+        w.u64(fullBlockSize(b));
+        encodeFullBlock(w, b); // streamed, no per-block buffer
+    }
+
+    try {
+        sink.flush();
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("saveChainFile: write failed for " + path);
+    }
+}
+
+std::vector<std::vector<uint8_t>> loadChainFile(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        throw std::runtime_error("loadChainFile: cannot open " + path);
+    }
+    std::vector<uint8_t> buf((std::istreambuf_iterator<char>(f)),
+                             std::istreambuf_iterator<char>());
+
+    ByteReader r(buf, "loadChainFile");
+    if (r.u32() != CHAIN_FILE_MAGIC) {
+        throw std::runtime_error("loadChainFile: not a chain file: " + path);
+    }
+    if (r.u32() != CHAIN_FILE_VERSION) {
+        throw std::runtime_error("loadChainFile: unsupported version in " + path);
+    }
+
+    uint64_t count = r.u64();
+    if (count > r.remaining() / 8) {
+        r.fail("bad block count");
+    }
+    std::vector<std::vector<uint8_t>> blocks(static_cast<size_t>(count));
+    for (auto& data : blocks) {
+        data = r.bytes();
+    }
+    return blocks;
+}
@@ -0,0 +1,45 @@
+#include "crypto_registry.h"
+#include "crypto_factory.h"
+#include <stdexcept>
+
+void CryptoRegistry::add(std::shared_ptr<Crypto> crypto) {
+    if (!crypto) {
+        throw std::runtime_error("CryptoRegistry::add: null backend");
+    }
+    size_t slot = static_cast<size_t>(crypto->schemeId());
+    if (slot == 0 || slot >= backends_.size()) {
+        throw std::runtime_error("CryptoRegistry::add: bad scheme id for " + crypto->name());
+    }
+    backends_[slot] = std::move(crypto);
+}
+
+std::shared_ptr<Crypto> CryptoRegistry::get(SchemeId id) const {
+    size_t slot = static_cast<size_t>(id);
+    if (slot >= backends_.size()) {
+        return nullptr;
+    }
+    return backends_[slot];
+}
+
+bool CryptoRegistry::contains(SchemeId id) const {
+    size_t slot = static_cast<size_t>(id);
+    return slot < backends_.size() && backends_[slot] != nullptr;
+}
+
+std::vector<SchemeId> CryptoRegistry::schemes() const {
+    std::vector<SchemeId> out;
+    for (size_t i = 1; i < backends_.size(); ++i) {
+        if (backends_[i]) {
+            out.push_back(static_cast<SchemeId>(i));
+        }
+    }
+    return out;
+}
+
+CryptoRegistry CryptoRegistry::fromConfigs(const std::vector<AlgoConfig>& cfgs) {
+    CryptoRegistry reg;
+    for (const auto& cfg : cfgs) {
+        reg.add(createCrypto(cfg));
+    }
+    return reg;
+}
@@ -0,0 +1,165 @@
+#include "fork_tree.h"
+#include "blockchain.h"
+#include "timing.h"
+#include <algorithm>
+
+ForkTree::ForkTree(std::shared_ptr<Crypto> crypto, ForkChoice rule)
+    : rule_(rule) {
+    registry_.add(std::move(crypto));
+    init();
+}
+
+ForkTree::ForkTree(CryptoRegistry registry, ForkChoice rule)
+    : registry_(std::move(registry)), rule_(rule) {
+    init();
+}
+
+void ForkTree::init() {
+    auto node = std::make_unique<Node>();
+    node->block = makeGenesisBlock();
+    node->chain_weight = 1;
+    genesis_ = tip_ = node.get();
+    nodes_.emplace(node->block.block_hash, std::move(node));
+}
+
+Block ForkTree::createBlock(const Block& parent,
+                            const std::vector<Transaction>& txs,
+                            uint64_t timestamp) {
+    Block b;
+    b.index = parent.index + 1;
+    b.prev_hash = parent.block_hash;
+    b.timestamp = timestamp;
+    b.transactions = txs;
+    b.witness_root = computeWitnessRoot(b);
+    b.block_hash = computeBlockHash(b);
+    return b;
+}
+
+bool ForkTree::better(const Node& a, const Node& b) const {
+    // Ties keep the block seen first.
+    if (rule_ == ForkChoice::HEAVIEST) {
+        return a.chain_weight > b.chain_weight;
+    }
+    return a.height > b.height;
+}
+
+AddBlockResult ForkTree::addBlock(const Block& block) {
+    AddBlockResult res;
+    if (contains(block.block_hash)) {
+        res.status = AddBlockStatus::DUPLICATE;
+        return res;
+    }
+    auto pit = nodes_.find(block.prev_hash);
+    if (pit == nodes_.end()) {
+        res.status = AddBlockStatus::ORPHAN;
+        return res;
+    }
+    Node* parent = pit->second.get();
+
+    // Context-free checks, done exactly once per block.
+    if (parent->invalid ||
+        !checkLinkageAndHash(parent->block, block) ||
+        block.witness_pruned || !checkWitness(block)) {
+        return res;
+    }
+    sigs_verified_ += block.transactions.size();
+    if (!verifyBlockSignatures(registry_, block)) {
+        return res;
+    }
+
+    auto node = std::make_unique<Node>();
+    node->block = block;
+    dropTxEncodings(node->block);
+    node->parent = parent;
+    node->height = parent->height + 1;
+    node->chain_weight = parent->chain_weight + 1 + block.transactions.size();
+    node->accounts = txAccountsFor(node->block);
+    Node* n = node.get();
+    nodes_.emplace(block.block_hash, std::move(node));
+
+    if (!better(*n, *tip_)) {
+        res.status = AddBlockStatus::SIDE_BRANCH;
+        return res;
+    }
+
+    bool extends_tip = (parent == tip_);
+    if (!reorgTo(n, res.reorg)) {
+        res.status = AddBlockStatus::INVALID; // stored, but marked invalid
+        return res;
+    }
+    res.status = extends_tip ? AddBlockStatus::ADDED_TO_TIP : AddBlockStatus::REORGED;
+    return res;
+}
+
+bool ForkTree::reorgTo(Node* target, ReorgStats& stats) {
+    uint64_t t1 = nowMicros();
+
+    // Find the fork point.
+    Node* a = tip_;
+    Node* b = target;
+    while (a->height > b->height) a = a->parent;
+    while (b->height > a->height) b = b->parent;
+    while (a != b) {
+        a = a->parent;
+        b = b->parent;
+    }
+    Node* fork = a;
+
+    // Disconnect the old branch, newest first.
+    std::vector<Node*> old_branch;
+    for (Node* n = tip_; n != fork; n = n->parent) {
+        state_.disconnectBlock(n->undo);
+        n->undo.entries.clear();
+        old_branch.push_back(n);
+    }
+
+    // Connect the new branch, oldest first.
+    std::vector<Node*> new_branch;
+    for (Node* n = target; n != fork; n = n->parent) {
+        new_branch.push_back(n);
+    }
+    std::reverse(new_branch.begin(), new_branch.end());
+
+    size_t connected = 0;
+    bool ok = true;
+    for (Node* n : new_branch) {
+        if (n->invalid || !state_.connectBlock(n->block, n->accounts, n->undo)) {
+            // n and everything above it on this branch can never connect.
+            for (size_t i = connected; i < new_branch.size(); ++i) {
+                new_branch[i]->invalid = true;
+            }
+            ok = false;
+            break;
+        }
+        ++connected;
+    }
+
+    if (!ok) {
+        // Back out what was connected and restore the old branch (which
+        // connected before, so it connects again).
+        for (size_t i = connected; i-- > 0;) {
+            state_.disconnectBlock(new_branch[i]->undo);
+            new_branch[i]->undo.entries.clear();
+        }
+        for (auto it = old_branch.rbegin(); it != old_branch.rend(); ++it) {
+            state_.connectBlock((*it)->block, (*it)->accounts, (*it)->undo);
+        }
+        stats.elapsed_us = nowMicros() - t1;
+        return false;
+    }
+
+    tip_ = target;
+    stats.disconnected = old_branch.size();
+    stats.connected = new_branch.size();
+    stats.elapsed_us = nowMicros() - t1;
+    return true;
+}
+
+std::vector<const Block*> ForkTree::activeChain() const {
+    std::vector<const Block*> out;
+    for (const Node* n = tip_; n; n = n->parent) {
+        out.push_back(&n->block);
+    }
+    std::reverse(out.begin(), out.end());
+    return out;
+}
@@ -1,7 +1,7 @@
 #include "hawk_crypto.h"
+#include "randomness.h"
 #include <stdexcept>
 #include <algorithm>
-#include <ctime>    // time()
 
 HawkCrypto::HawkCrypto(const std::string& variant)
     : variant_(variant)
@@ -22,19 +22,18 @@ HawkCrypto::HawkCrypto(const std::string& variant)
     tmp_s_ = HAWK_TMPSIZE_SIGN(logn_);
     tmp_v_ = HAWK_TMPSIZE_VERIFY(logn_);
 
+    expanded_len_ = HAWK_EXPANDED_PRIVKEY_SIZE(logn_);
+
     tmp_len_ = tmp_k_;
     if (tmp_s_ > tmp_len_) tmp_len_ = tmp_s_;
     if (tmp_v_ > tmp_len_) tmp_len_ = tmp_v_;
 
-    // RNG init (same style as your bench)
-    uint64_t tq = (uint64_t)time(nullptr);
-    shake_init(&rng_, 256);
-    shake_inject(&rng_, &tq, sizeof tq);
-    shake_flip(&rng_);
+    metrics_ = CryptoMetrics::forAlgorithm(name());
 }
 
 std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
 HawkCrypto::generateKeypair() {
+    ScopedLatency timer(*metrics_.keygen);
     std::vector<uint8_t> sk(priv_len_);
     std::vector<uint8_t> pk(pub_len_);
     std::vector<uint8_t> tmp(tmp_len_);
@@ -42,7 +41,7 @@ HawkCrypto::generateKeypair() {
     int ok = hawk_keygen(logn_,
                          sk.data(),  // priv
                          pk.data(),  // pub
-                         (hawk_rng)&shake_extract, &rng_,
+                         &hawkRandomBytes, nullptr,
                          tmp.data(), tmp_k_);
     if (!ok) {
         throw std::runtime_error("Hawk keygen failed");
@@ -54,7 +53,14 @@ HawkCrypto::generateKeypair() {
 std::vector<uint8_t>
 HawkCrypto::sign(const std::vector<uint8_t>& msg,
                  const std::vector<uint8_t>& sk) {
-    if (sk.size() != priv_len_) {
+    return signWithKey(msg, sk.data(), sk.size());
+}
+
+std::vector<uint8_t>
+HawkCrypto::signWithKey(const std::vector<uint8_t>& msg,
+                        const uint8_t* sk, size_t sk_len) {
+    ScopedLatency timer(*metrics_.sign);
+    if (sk_len != priv_len_) {
         throw std::runtime_error("Hawk sign: unexpected secret key size");
     }
 
@@ -68,9 +74,9 @@ HawkCrypto::sign(const std::vector<uint8_t>& msg,
     }
 
     int ok = hawk_sign_finish(logn_,
-                              (hawk_rng)&shake_extract, &rng_,
+                              &hawkRandomBytes, nullptr,
                               sig.data(), &scd,
-                              sk.data(),
+                              sk,
                               tmp.data(), tmp_s_);
     if (!ok) {
         throw std::runtime_error("Hawk sign failed");
@@ -80,15 +86,67 @@ HawkCrypto::sign(const std::vector<uint8_t>& msg,
     return sig;
 }
 
+namespace {
+struct HawkPreparedKey : PreparedKey {
+    std::vector<uint8_t> expanded;
+};
+}
+
+std::shared_ptr<const PreparedKey>
+HawkCrypto::prepareSigningKey(const std::vector<uint8_t>& sk) {
+    if (sk.size() != priv_len_) {
+        throw std::runtime_error("Hawk prepare: unexpected secret key size");
+    }
+
+    auto key = std::make_shared<HawkPreparedKey>();
+    key->scheme = schemeId();
+    key->expanded.resize(expanded_len_);
+    std::vector<uint8_t> tmp(HAWK_TMPSIZE_EXPANDPRIV(logn_));
+    hawk_expand_privkey(logn_, key->expanded.data(), sk.data(),
+                        tmp.data(), tmp.size());
+    return key;
+}
+
+std::vector<uint8_t>
+HawkCrypto::signPrepared(const std::vector<uint8_t>& msg, const PreparedKey& key) {
+    ScopedLatency timer(*metrics_.sign);
+    const auto* k = dynamic_cast<const HawkPreparedKey*>(&key);
+    if (!k || key.scheme != schemeId()) {
+        throw std::runtime_error("Hawk sign: key was prepared for another scheme");
+    }
+
+    std::vector<uint8_t> sig(sig_len_);
+    std::vector<uint8_t> tmp(HAWK_TMPSIZE_SIGN_ALT(logn_));
+
+    shake_context scd;
+    hawk_sign_start(&scd);
+    if (!msg.empty()) {
+        shake_inject(&scd, msg.data(), msg.size());
+    }
+
+    int ok = hawk_sign_finish_alt(logn_,
+                                  &hawkRandomBytes, nullptr,
+                                  sig.data(), &scd,
+                                  k->expanded.data(),
+                                  tmp.data(), tmp.size());
+    if (!ok) {
+        throw std::runtime_error("Hawk sign failed");
+    }
+    return sig;
+}
+
 bool
 HawkCrypto::verify(const std::vector<uint8_t>& msg,
                    const std::vector<uint8_t>& sig,
                    const std::vector<uint8_t>& pk) {
+    ScopedLatency timer(*metrics_.verify);
     if (pk.size() != pub_len_) {
+        metrics_.failed->inc();
         return false;
     }
     if (sig.size() != sig_len_) {
         // Depending on Hawk encoding, you can relax this if needed.
+        metrics_.failed->inc();
         return false;
     }
 
@@ -105,6 +163,7 @@ HawkCrypto::verify(const std::vector<uint8_t>& msg,
                                 &scd,
                                 pk.data(), pub_len_,
                                 tmp.data(), tmp_v_);
+    (ok ? metrics_.verified : metrics_.failed)->inc();
     return ok != 0;
 }
 
@@ -112,6 +171,10 @@ std::string HawkCrypto::name() const {
     return "Hawk-" + variant_;
 }
 
+SchemeId HawkCrypto::schemeId() const {
+    return schemeIdFor({AlgoFamily::HAWK, variant_});
+}
+
 size_t HawkCrypto::publicKeySize() const {
     return pub_len_;
 }
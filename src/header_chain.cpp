@@ -0,0 +1,77 @@
+#include "header_chain.h"
+#include "blockchain.h"
+#include "body_store.h"
+#include <stdexcept>
+#include <string>
+
+HeaderChain::HeaderChain() : HeaderChain(blockHeaderOf(makeGenesisBlock())) {}
+
+HeaderChain::HeaderChain(const BlockHeader& genesis) {
+    headers_.push_back(genesis);
+    by_hash_.emplace(genesis.block_hash, genesis.index);
+}
+
+bool HeaderChain::append(const BlockHeader& header) {
+    const BlockHeader& prev = tip();
+    if (header.index != prev.index + 1 || header.prev_hash != prev.block_hash) {
+        return false;
+    }
+    if (computeHeaderHash(header) != header.block_hash) {
+        return false;
+    }
+    if (!by_hash_.emplace(header.block_hash, header.index).second) {
+        return false;
+    }
+    headers_.push_back(header);
+    return true;
+}
+
+size_t HeaderChain::appendAll(const std::vector<BlockHeader>& headers) {
+    size_t n = 0;
+    for (const auto& h : headers) {
+        if (!append(h)) {
+            break;
+        }
+        ++n;
+    }
+    return n;
+}
+
+void HeaderChain::reserve(size_t headers) {
+    headers_.reserve(headers);
+    by_hash_.reserve(headers);
+}
+
+const BlockHeader& HeaderChain::at(uint32_t height) const {
+    uint32_t base = headers_.front().index;
+    if (height < base || height - base >= headers_.size()) {
+        throw std::runtime_error("HeaderChain: height out of range");
+    }
+    return headers_[height - base];
+}
+
+bool HeaderChain::find(const std::array<uint8_t, 32>& hash, uint32_t& height) const {
+    auto it = by_hash_.find(hash);
+    if (it == by_hash_.end()) {
+        return false;
+    }
+    height = it->second;
+    return true;
+}
+
+Block HeaderChain::loadBlock(uint32_t height, const BodyStore& bodies) const {
+    const BlockHeader& h = at(height);
+    BlockBody body = bodies.load(height);
+    if (!bodyMatchesHeader(h, body)) {
+        throw std::runtime_error("HeaderChain: body does not match header at height " +
+                                 std::to_string(height));
+    }
+    return assembleBlock(h, std::move(body));
+}
+
+size_t HeaderChain::memoryFootprint() const {
+    // Map nodes: key + value + next pointer + cached hash, roughly.
+    size_t node = sizeof(std::array<uint8_t, 32>) + sizeof(uint32_t) + 2 * sizeof(void*);
+    return sizeof(*this) + headers_.capacity() * sizeof(BlockHeader) +
+           by_hash_.size() * node + by_hash_.bucket_count() * sizeof(void*);
+}
@@ -0,0 +1,126 @@
+#include "keypair_pool.h"
+#include "crypto_factory.h"
+#include "timing.h"
+#include <stdexcept>
+
+KeypairPool::KeypairPool(const AlgoConfig& cfg, size_t capacity, size_t worker_count)
+    : scheme_(schemeIdFor(cfg)),
+      capacity_(capacity),
+      start_us_(nowMicros())
+{
+    if (capacity == 0 || worker_count == 0) {
+        throw std::runtime_error("KeypairPool: capacity and worker_count must be > 0");
+    }
+    // Create all backends up front so a bad config throws here,
+    // not inside a worker thread.
+    std::vector<std::shared_ptr<Crypto>> backends;
+    for (size_t i = 0; i < worker_count; ++i) {
+        backends.push_back(createCrypto(cfg));
+    }
+
+    MetricsRegistry& reg = metrics();
+    MetricLabels l = {{"alg", backends.front()->name()}};
+    hit_counter_ = &reg.counter("pqbc_keypair_pool_hits_total", "Keypair pool takes served immediately", l);
+    miss_counter_ = &reg.counter("pqbc_keypair_pool_misses_total", "Keypair pool takes that found it empty", l);
+    ready_gauge_ = &reg.gauge("pqbc_keypair_pool_ready", "Keypairs ready in the pool", l);
+
+    for (auto& c : backends) {
+        workers_.emplace_back(&KeypairPool::workerLoop, this, std::move(c));
+    }
+}
+
+KeypairPool::~KeypairPool() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+    for (auto& t : workers_) {
+        t.join();
+    }
+    ready_gauge_->add(-static_cast<int64_t>(ready_.size()));
+}
+
+void KeypairPool::workerLoop(std::shared_ptr<Crypto> crypto) {
+    std::unique_lock<std::mutex> lock(mu_);
+    for (;;) {
+        not_full_.wait(lock, [this] {
+            return stop_ || ready_.size() + in_flight_ < capacity_;
+        });
+        if (stop_) {
+            return;
+        }
+
+        // Reserve the slot, then run keygen without holding the lock.
+        ++in_flight_;
+        lock.unlock();
+        auto t1 = nowMicros();
+        Keypair kp = crypto->generateKeypair();
+        auto t2 = nowMicros();
+        lock.lock();
+        --in_flight_;
+
+        ready_.push_back(std::move(kp));
+        ready_gauge_->add(1);
+        ++stats_.generated;
+        stats_.keygen_total_us += (t2 - t1);
+        not_empty_.notify_all();
+    }
+}
+
+KeypairPool::Keypair KeypairPool::take() {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (ready_.empty()) {
+        ++stats_.misses;
+        miss_counter_->inc();
+        not_empty_.wait(lock, [this] { return stop_ || !ready_.empty(); });
+        if (ready_.empty()) {
+            throw std::runtime_error("KeypairPool::take: pool stopped");
+        }
+    } else {
+        ++stats_.hits;
+        hit_counter_->inc();
+    }
+
+    Keypair kp = std::move(ready_.front());
+    ready_.pop_front();
+    ready_gauge_->add(-1);
+    lock.unlock();
+    not_full_.notify_one();
+    return kp;
+}
+
+bool KeypairPool::tryTake(Keypair& out) {
+    std::unique_lock<std::mutex> lock(mu_);
+    if (ready_.empty()) {
+        ++stats_.misses;
+        miss_counter_->inc();
+        return false;
+    }
+    ++stats_.hits;
+    hit_counter_->inc();
+    out = std::move(ready_.front());
+    ready_.pop_front();
+    ready_gauge_->add(-1);
+    lock.unlock();
+    not_full_.notify_one();
+    return true;
+}
+
+void KeypairPool::waitUntilFull() {
+    std::unique_lock<std::mutex> lock(mu_);
+    not_empty_.wait(lock, [this] { return stop_ || ready_.size() >= capacity_; });
+}
+
+size_t KeypairPool::size() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return ready_.size();
+}
+
+KeypairPoolStats KeypairPool::stats() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    KeypairPoolStats s = stats_;
+    s.uptime_us = nowMicros() - start_us_;
+    return s;
+}
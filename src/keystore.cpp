@@ -0,0 +1,199 @@
+#include "keystore.h"
+#include "byte_codec.h"
+#include "crypto_factory.h"
+#include "thread_pool.h"
+#include "timing.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+
+static const uint32_t KEYSTORE_MAGIC   = 0x534B5150u; // "PQKS" little-endian
+static const uint32_t KEYSTORE_VERSION = 1;
+static const size_t HEADER_LEN = 64;
+static const size_t ID_LEN = 32;
+static const size_t INDEX_ENTRY_LEN = ID_LEN + 8;
+
+static size_t recordLen(size_t pk_len, size_t sk_len) {
+    return (ID_LEN + pk_len + sk_len + 7) & ~static_cast<size_t>(7);
+}
+
+AccountId KeystoreEntry::accountId() const {
+    AccountId out;
+    std::memcpy(out.data(), id, out.size());
+    return out;
+}
+
+std::vector<uint8_t> KeystoreEntry::publicKey() const {
+    return std::vector<uint8_t>(pk, pk + pk_len);
+}
+
+KeystoreGenStats Keystore::generate(const std::string& path, const AlgoConfig& cfg,
+                                    size_t count, unsigned threads) {
+    if (threads == 0) {
+        throw std::runtime_error("Keystore: threads must be > 0");
+    }
+    // One backend per worker, as in KeypairPool; create them here so a bad
+    // config throws before the file is touched.
+    std::vector<std::shared_ptr<Crypto>> backends;
+    for (unsigned i = 0; i < threads; ++i) {
+        backends.push_back(createCrypto(cfg));
+    }
+    const size_t pk_len = backends.front()->publicKeySize();
+    const size_t sk_len = backends.front()->secretKeySize();
+    const size_t rec_len = recordLen(pk_len, sk_len);
+    const size_t records_at = HEADER_LEN;
+    const size_t index_at = records_at + count * rec_len;
+
+    KeystoreGenStats stats;
+    stats.keys = count;
+    stats.threads = threads;
+    auto t1 = nowMicros();
+
+    MappedFile file = MappedFile::create(path, index_at + count * INDEX_ENTRY_LEN);
+    uint8_t* base = file.mutableData();
+
+    // Workers claim record numbers from a shared counter and write each
+    // keypair directly into its slot.
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    {
+        ThreadPool pool(threads);
+        std::vector<std::future<void>> done;
+        for (auto& crypto : backends) {
+            done.push_back(pool.submit([&, crypto] {
+                try {
+                    while (!failed.load(std::memory_order_relaxed)) {
+                        size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                        if (i >= count) {
+                            break;
+                        }
+                        auto [pk, sk] = crypto->generateKeypair();
+                        if (pk.size() != pk_len || sk.size() != sk_len) {
+                            throw std::runtime_error("Keystore: " + crypto->name() +
+                                                     " produced a key of unexpected size");
+                        }
+                        AccountId id = accountIdFor(pk);
+                        uint8_t* rec = base + records_at + i * rec_len;
+                        std::memcpy(rec, id.data(), ID_LEN);
+                        std::memcpy(rec + ID_LEN, pk.data(), pk_len);
+                        std::memcpy(rec + ID_LEN + pk_len, sk.data(), sk_len);
+                    }
+                } catch (...) {
+                    failed = true;
+                    throw;
+                }
+            }));
+        }
+        for (auto& f : done) {
+            f.get(); // rethrows the first worker error
+        }
+    }
+
+    // Index sorted by account id.
+    std::vector<std::pair<AccountId, uint64_t>> index(count);
+    for (size_t i = 0; i < count; ++i) {
+        std::memcpy(index[i].first.data(), base + records_at + i * rec_len, ID_LEN);
+        index[i].second = i;
+    }
+    std::sort(index.begin(), index.end());
+    BufferSink index_sink(base + index_at, count * INDEX_ENTRY_LEN);
+    ByteWriter<BufferSink> iw(index_sink);
+    for (const auto& e : index) {
+        iw.raw(e.first);
+        iw.u64(e.second);
+    }
+
+    // Header last: an interrupted run leaves a file open() rejects.
+    BufferSink header_sink(base, HEADER_LEN);
+    ByteWriter<BufferSink> hw(header_sink);
+    hw.u32(KEYSTORE_MAGIC);
+    hw.u32(KEYSTORE_VERSION);
+    hw.u32(static_cast<uint32_t>(schemeIdFor(cfg)));
+    hw.u32(static_cast<uint32_t>(pk_len));
+    hw.u32(static_cast<uint32_t>(sk_len));
+    hw.u32(static_cast<uint32_t>(rec_len));
+    hw.u64(count);
+    file.flush();
+
+    stats.elapsed_us = nowMicros() - t1;
+    return stats;
+}
+
+std::shared_ptr<const Keystore> Keystore::open(const std::string& path) {
+    return std::shared_ptr<const Keystore>(new Keystore(MappedFile::openReadOnly(path), path));
+}
+
+Keystore::Keystore(MappedFile file, const std::string& path)
+    : file_(std::move(file)) {
+    const std::string context = "Keystore '" + path + "'";
+    if (file_.size() < HEADER_LEN) {
+        throw std::runtime_error(context + ": truncated header");
+    }
+    ByteReader r(file_.data(), HEADER_LEN, context.c_str());
+    if (r.u32() != KEYSTORE_MAGIC) {
+        r.fail("bad magic");
+    }
+    if (r.u32() != KEYSTORE_VERSION) {
+        r.fail("unsupported version");
+    }
+    uint32_t scheme = r.u32();
+    if (scheme == 0 || scheme >= SCHEME_ID_COUNT) {
+        r.fail("unknown scheme id");
+    }
+    scheme_ = static_cast<SchemeId>(scheme);
+    pk_len_ = r.u32();
+    sk_len_ = r.u32();
+    record_len_ = r.u32();
+    uint64_t count = r.u64();
+    if (pk_len_ == 0 || sk_len_ == 0 || record_len_ != recordLen(pk_len_, sk_len_)) {
+        r.fail("bad record layout");
+    }
+    size_t body = file_.size() - HEADER_LEN;
+    if (count > body / (record_len_ + INDEX_ENTRY_LEN) ||
+        body != count * (record_len_ + INDEX_ENTRY_LEN)) {
+        r.fail("file size does not match record count");
+    }
+    count_ = static_cast<size_t>(count);
+    records_ = file_.data() + HEADER_LEN;
+    index_ = records_ + count_ * record_len_;
+}
+
+KeystoreEntry Keystore::entry(size_t index) const {
+    if (index >= count_) {
+        throw std::runtime_error("Keystore: entry index out of range");
+    }
+    const uint8_t* rec = records_ + index * record_len_;
+    KeystoreEntry e;
+    e.id = rec;
+    e.pk = rec + ID_LEN;
+    e.pk_len = pk_len_;
+    e.sk = rec + ID_LEN + pk_len_;
+    e.sk_len = sk_len_;
+    return e;
+}
+
+bool Keystore::find(const AccountId& id, size_t& index) const {
+    size_t lo = 0, hi = count_;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        const uint8_t* e = index_ + mid * INDEX_ENTRY_LEN;
+        int c = std::memcmp(e, id.data(), ID_LEN);
+        if (c == 0) {
+            ByteReader r(e + ID_LEN, 8, "Keystore index");
+            uint64_t rec = r.u64();
+            if (rec >= count_) {
+                throw std::runtime_error("Keystore: index entry out of range");
+            }
+            index = static_cast<size_t>(rec);
+            return true;
+        }
+        if (c < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
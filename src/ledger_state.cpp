@@ -0,0 +1,86 @@
+#include "ledger_state.h"
+#include "block_utils.h"
+#include <limits>
+
+AccountId accountIdFor(const std::vector<uint8_t>& pubkey) {
+    return simpleHash32(pubkey);
+}
+
+TxAccounts txAccountsFor(const Block& block) {
+    TxAccounts out;
+    out.reserve(block.transactions.size());
+    for (const auto& tx : block.transactions) {
+        out.emplace_back(accountIdFor(tx.from_pubkey), accountIdFor(tx.to_pubkey));
+    }
+    return out;
+}
+
+AccountState& LedgerState::touch(const AccountId& id, UndoJournal& undo) {
+    auto it = accounts_.find(id);
+    if (it == accounts_.end()) {
+        undo.entries.push_back({id, false, AccountState{}});
+        return accounts_[id];
+    }
+    undo.entries.push_back({id, true, it->second});
+    return it->second;
+}
+
+// balance - amount / balance + amount, false instead of signed overflow.
+static bool debit(int64_t& balance, int64_t amount) {
+    if (balance < std::numeric_limits<int64_t>::min() + amount) {
+        return false;
+    }
+    balance -= amount;
+    return true;
+}
+
+static bool credit(int64_t& balance, int64_t amount) {
+    if (balance > std::numeric_limits<int64_t>::max() - amount) {
+        return false;
+    }
+    balance += amount;
+    return true;
+}
+
+bool LedgerState::connectBlock(const Block& block, const TxAccounts& accounts,
+                               UndoJournal& undo) {
+    undo.entries.clear();
+    undo.entries.reserve(2 * block.transactions.size());
+
+    for (size_t i = 0; i < block.transactions.size(); ++i) {
+        const Transaction& tx = block.transactions[i];
+        AccountState& from = touch(accounts[i].first, undo);
+        bool ok = tx.nonce == from.nonce + 1 &&
+                  tx.amount <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        int64_t amount = static_cast<int64_t>(tx.amount);
+        if (ok) {
+            from.nonce = tx.nonce;
+            ok = debit(from.balance, amount);
+        }
+        if (ok) {
+            AccountState& to = touch(accounts[i].second, undo);
+            ok = credit(to.balance, amount);
+        }
+        if (!ok) {
+            disconnectBlock(undo);
+            undo.entries.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void LedgerState::disconnectBlock(const UndoJournal& undo) {
+    for (auto it = undo.entries.rbegin(); it != undo.entries.rend(); ++it) {
+        if (it->existed) {
+            accounts_[it->id] = it->prev;
+        } else {
+            accounts_.erase(it->id);
+        }
+    }
+}
+
+AccountState LedgerState::account(const AccountId& id) const {
+    auto it = accounts_.find(id);
+    return it == accounts_.end() ? AccountState{} : it->second;
+}
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <memory>
 #include <vector>
+#include <string>
 #include <iomanip>
 #include <sstream>
 
@@ -12,6 +13,9 @@
 #include "blockchain.h"
 #include "block.h"
 #include "transaction.h"
+#include "metrics.h"
+#include "mem_accounting.h"
+#include "randomness.h"
 
 // Helper: convert bytes to hex string
 std::string toHex(const uint8_t* data, size_t len, size_t maxLen = 64) {
@@ -31,7 +35,44 @@ std::string hashToHex(const std::array<uint8_t, 32>& h) {
     return toHex(h.data(), h.size());
 }
 
-int main() {
+// Usage: crypto_blockchain.exe [--mem] [--rng=MODE] [metrics_file [prom|json]]
+// With a metrics file, a snapshot is written every second and at exit.
+// --mem counts allocations per phase and prints a memory table at the end
+// (only in builds with PQBC_MEM_ACCOUNTING defined).
+// --rng picks the randomness mode (see randomness.h); default buffered.
+int main(int argc, char** argv) {
+    std::vector<std::string> args;
+    bool mem = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--mem") {
+            mem = true;
+        } else if (a.rfind("--rng=", 0) == 0) {
+            if (!setRngModeFromString(a.substr(6))) {
+                std::cerr << "Unknown RNG mode: " << a.substr(6) << "\n";
+                return 1;
+            }
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (mem && !memAccountingBuiltIn()) {
+        std::cerr << "--mem needs a build with PQBC_MEM_ACCOUNTING defined\n";
+        return 1;
+    }
+    setMemAccountingEnabled(mem);
+    if (memAccountingBuiltIn()) {
+        std::cout << "[Memory] Built with PQBC_MEM_ACCOUNTING: every allocation carries a "
+                     "16-byte header, so timings differ from a normal build.\n";
+    }
+
+    std::unique_ptr<MetricsExporter> exporter;
+    if (!args.empty()) {
+        MetricsFormat fmt = (args.size() > 1 && args[1] == "json")
+            ? MetricsFormat::JSON : MetricsFormat::PROMETHEUS;
+        exporter = std::make_unique<MetricsExporter>(args[0], fmt, 1000);
+    }
+
     // 1. Select algorithm
     AlgoConfig cfg = getSelectedAlgorithm();
     auto crypto = createCrypto(cfg);
@@ -39,7 +80,11 @@ int main() {
     std::cout << "=== Blockchain benchmark ===\n";
     std::cout << "Algorithm: " << crypto->name()
               << " (family=" << crypto->family()
-              << ", variant=" << crypto->variant() << ")\n\n";
+              << ", variant=" << crypto->variant() << ")\n";
+    RngCost rng_cost = measureRngCost();
+    std::cout << "RNG: " << rngDescription() << ", " << std::fixed << std::setprecision(1)
+              << rng_cost.ns_per_draw << " ns per " << rng_cost.draw_bytes << "-byte draw\n\n";
+    std::cout.unsetf(std::ios::fixed);
 
     // 2. Keygen benchmark: 100 wallets
     const size_t WALLET_COUNT = 100;
@@ -48,12 +93,15 @@ int main() {
     std::cout << "[Keygen] Generating " << WALLET_COUNT
               << " wallets to measure keygen performance...\n";
 
-    for (size_t i = 0; i < WALLET_COUNT; ++i) {
-        auto t1 = nowMicros();
-        auto [pk, sk] = crypto->generateKeypair();
-        auto t2 = nowMicros();
-        keygen_total_us += (t2 - t1);
-        (void)pk; (void)sk; // not used further here
+    {
+        MemPhaseScope mem_scope(MemPhase::KEYGEN);
+        for (size_t i = 0; i < WALLET_COUNT; ++i) {
+            auto t1 = nowMicros();
+            auto [pk, sk] = crypto->generateKeypair();
+            auto t2 = nowMicros();
+            keygen_total_us += (t2 - t1);
+            (void)pk; (void)sk; // not used further here
+        }
     }
 
     double keygen_avg_us = static_cast<double>(keygen_total_us) / WALLET_COUNT;
@@ -65,8 +113,11 @@ int main() {
 
     Wallet alice(crypto);
     Wallet bob(crypto);
-    alice.generateNewKeypair();
-    bob.generateNewKeypair();
+    {
+        MemPhaseScope mem_scope(MemPhase::KEYGEN);
+        alice.generateNewKeypair();
+        bob.generateNewKeypair();
+    }
 
     std::cout << "[Wallets] Alice PK size: " << alice.publicKey().size() << " bytes\n";
     std::cout << "[Wallets] Bob   PK size: " << bob.publicKey().size()   << " bytes\n\n";
@@ -81,12 +132,15 @@ int main() {
     std::cout << "[Tx] Creating and signing " << TX_PER_BLOCK
               << " transactions (Alice -> Bob)...\n";
 
-    for (uint64_t i = 1; i <= TX_PER_BLOCK; ++i) {
-        auto t1 = nowMicros();
-        Transaction tx = alice.createTransaction(bob.publicKey(), i, i); // amount = nonce = i
-        auto t2 = nowMicros();
-        sign_total_us += (t2 - t1);
-        txs.push_back(std::move(tx));
+    {
+        MemPhaseScope mem_scope(MemPhase::SIGN);
+        for (uint64_t i = 1; i <= TX_PER_BLOCK; ++i) {
+            auto t1 = nowMicros();
+            Transaction tx = alice.createTransaction(bob.publicKey(), i, i); // amount = nonce = i
+            auto t2 = nowMicros();
+            sign_total_us += (t2 - t1);
+            txs.push_back(std::move(tx));
+        }
     }
 
     double sign_avg_us = static_cast<double>(sign_total_us) / TX_PER_BLOCK;
@@ -94,7 +148,19 @@ int main() {
     std::cout << "Avg tx sign time (in block context): " << sign_avg_us << " us\n\n";
 
     // 5. Build block 1
-    Block block1 = chain.createBlockWithTransactions(txs);
+    Block block1;
+    {
+        MemPhaseScope mem_scope(MemPhase::BUILD_BLOCK);
+        block1 = chain.createBlockWithTransactions(txs);
+    }
+    {
+        // Re-hash once on its own so hashing shows up as a separate phase.
+        MemPhaseScope mem_scope(MemPhase::HASH);
+        if (computeBlockHash(block1) != block1.block_hash) {
+            std::cerr << "Block hash is not reproducible. Aborting.\n";
+            return 1;
+        }
+    }
 
     std::cout << "[Block] Block index: " << block1.index << "\n";
     std::cout << "[Block] Tx count:    " << block1.transactions.size() << "\n";
@@ -119,7 +185,11 @@ int main() {
     }
 
     // 5b. Compute serialized block size
-    std::vector<uint8_t> serialized = serializeFullBlock(block1);
+    std::vector<uint8_t> serialized;
+    {
+        MemPhaseScope mem_scope(MemPhase::SERIALIZE);
+        serialized = serializeFullBlock(block1);
+    }
     size_t block_size_bytes = serialized.size();
     double avg_tx_size_bytes = static_cast<double>(block_size_bytes) / TX_PER_BLOCK;
 
@@ -158,7 +228,11 @@ int main() {
 
     for (size_t i = 0; i < BLOCK_VERIFY_ITERS; ++i) {
         auto t1 = nowMicros();
-        bool ok = chain.validateBlock(block1);
+        bool ok;
+        {
+            MemPhaseScope mem_scope(MemPhase::VALIDATE, i + 1 == BLOCK_VERIFY_ITERS);
+            ok = chain.validateBlock(block1);
+        }
         auto t2 = nowMicros();
 
         if (!ok) {
@@ -179,5 +253,34 @@ int main() {
     std::cout << "[Benchmark] Avg verify time per tx:  "
               << verify_per_tx_us << " us\n";
 
+    // 9. Cost of one metrics hook (timed scope + counter), for reference
+    //    against the per-op times above.
+    {
+        const size_t HOOK_ITERS = 1000000;
+        Histogram& h = metrics().histogram("pqbc_overhead_probe_seconds", "Metrics hook self-test");
+        Counter& c = metrics().counter("pqbc_overhead_probe_total", "Metrics hook self-test");
+        uint64_t t1 = metricsNowNanos();
+        for (size_t i = 0; i < HOOK_ITERS; ++i) {
+            ScopedLatency timer(h);
+            c.inc();
+        }
+        uint64_t t2 = metricsNowNanos();
+        std::cout << "\n[Metrics] Hook overhead: "
+                  << static_cast<double>(t2 - t1) / HOOK_ITERS << " ns per timed op\n";
+        std::cout << "[Metrics] Signatures verified: "
+                  << metrics().counter("pqbc_signatures_verified_total", "", {{"alg", crypto->name()}}).value()
+                  << ", failed: "
+                  << metrics().counter("pqbc_signature_failures_total", "", {{"alg", crypto->name()}}).value()
+                  << "\n";
+        if (exporter) {
+            std::cout << "[Metrics] Snapshot file: " << args[0] << "\n";
+        }
+    }
+
+    if (mem) {
+        std::cout << "\n[Memory] Allocations by phase:\n";
+        printMemoryTable(std::cout);
+    }
+
     return 0;
 }
@@ -2,18 +2,48 @@
 #include <random>
 #include <memory>
 #include <vector>
+#include <string>
 #include "algo_config.h"
 #include "crypto.h"
 #include "crypto_factory.h"
 #include "timing.h"
+#include "mem_accounting.h"
+#include "randomness.h"
+
+// Usage: crypto_test.exe [--mem] [--rng=MODE]
+// --mem counts allocations per phase and prints a memory table at the end
+// (only in builds with PQBC_MEM_ACCOUNTING defined).
+// --rng picks the randomness mode (see randomness.h); default buffered.
+int main(int argc, char** argv) {
+    bool mem = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--mem") {
+            mem = true;
+        } else if (a.rfind("--rng=", 0) != 0 || !setRngModeFromString(a.substr(6))) {
+            std::cerr << "Unknown argument: " << a << "\n";
+            return 1;
+        }
+    }
+    if (mem && !memAccountingBuiltIn()) {
+        std::cerr << "--mem needs a build with PQBC_MEM_ACCOUNTING defined\n";
+        return 1;
+    }
+    setMemAccountingEnabled(mem);
+    if (memAccountingBuiltIn()) {
+        std::cout << "[Memory] Built with PQBC_MEM_ACCOUNTING: every allocation carries a "
+                     "16-byte header, so timings differ from a normal build.\n";
+    }
 
-int main() {
     AlgoConfig cfg = getSelectedAlgorithm();
     auto crypto = createCrypto(cfg);
 
     std::cout << "Algorithm: " << crypto->name()
               << " (family=" << crypto->family()
               << ", variant=" << crypto->variant() << ")\n";
+    RngCost rng_cost = measureRngCost();
+    std::cout << "RNG: " << rngDescription() << ", "
+              << rng_cost.ns_per_draw << " ns per " << rng_cost.draw_bytes << "-byte draw\n";
 
     // --------- 1) Single keygen for sizes + sanity ---------
     auto [pk, sk] = crypto->generateKeypair();
@@ -26,11 +56,14 @@ int main() {
     const size_t KEYGEN_ITERS = 1000;   // you can set to 10000 if you want
     uint64_t keygen_total_us = 0;
 
-    for (size_t i = 0; i < KEYGEN_ITERS; ++i) {
-        auto t1 = nowMicros();
-        auto [pk_tmp, sk_tmp] = crypto->generateKeypair();
-        auto t2 = nowMicros();
-        keygen_total_us += (t2 - t1);
+    {
+        MemPhaseScope mem_scope(MemPhase::KEYGEN);
+        for (size_t i = 0; i < KEYGEN_ITERS; ++i) {
+            auto t1 = nowMicros();
+            auto [pk_tmp, sk_tmp] = crypto->generateKeypair();
+            auto t2 = nowMicros();
+            keygen_total_us += (t2 - t1);
+        }
     }
 
     double keygen_avg_us = double(keygen_total_us) / KEYGEN_ITERS;
@@ -63,10 +96,22 @@ int main() {
             b = static_cast<uint8_t>(dist(rng));
         }
 
+        // RSS is sampled once, on the last iteration, to keep /proc reads
+        // out of the timed loop.
+        bool last = (i + 1 == ITERS);
+        std::vector<uint8_t> s;
+        bool ok2;
+
         auto t1 = nowMicros();
-        auto s  = crypto->sign(bench_msg, sk);
+        {
+            MemPhaseScope mem_scope(MemPhase::SIGN, last);
+            s = crypto->sign(bench_msg, sk);
+        }
         auto t2 = nowMicros();
-        bool ok2 = crypto->verify(bench_msg, s, pk);
+        {
+            MemPhaseScope mem_scope(MemPhase::VALIDATE, last);
+            ok2 = crypto->verify(bench_msg, s, pk);
+        }
         auto t3 = nowMicros();
 
         if (!ok2) {
@@ -85,5 +130,10 @@ int main() {
     std::cout << "Avg sign time:   " << sign_avg_us   << " us\n";
     std::cout << "Avg verify time: " << verify_avg_us << " us\n";
 
+    if (mem) {
+        std::cout << "\nMemory by phase (verify is reported as validate):\n";
+        printMemoryTable(std::cout);
+    }
+
     return 0;
 }
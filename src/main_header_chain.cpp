@@ -0,0 +1,187 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "metrics.h"
+#include "timing.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "body_store.h"
+#include "header_chain.h"
+#include "fork_tree.h"
+#include "mem_accounting.h"
+
+static double mb(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+static long long rssDelta(size_t before) {
+    return static_cast<long long>(currentRssBytes()) - static_cast<long long>(before);
+}
+
+// Usage: crypto_header_chain.exe [blocks] [tx_per_block] [body_file]
+// Builds a chain of 'blocks' blocks (the same few signed txs reused, so
+// building stays cheap), then syncs it twice: headers only into a
+// HeaderChain, and as full Blocks into a Blockchain.
+int main(int argc, char** argv) {
+    size_t block_count = argc > 1 ? static_cast<size_t>(std::atoll(argv[1])) : 100000;
+    size_t tx_per_block = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 2;
+    std::string path = argc > 3 ? argv[3] : "bodies.bin";
+    const size_t TX_POOL = 64;
+    const size_t RANDOM_LOADS = 1000;
+
+    setMetricsEnabled(false);
+
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    std::cout << "=== Header-chain sync benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << "), " << block_count
+              << " blocks x " << tx_per_block << " tx\n\n";
+
+    // 1. Build: headers into memory (as a peer would send them), bodies
+    //    into the body store. No Block is kept.
+    Wallet alice(crypto), bob(crypto);
+    alice.generateNewKeypair();
+    bob.generateNewKeypair();
+    std::vector<Transaction> pool;
+    for (uint64_t i = 1; i <= TX_POOL; ++i) {
+        pool.push_back(alice.createTransaction(bob.publicKey(), i, i));
+    }
+
+    auto t1 = nowMicros();
+    std::vector<uint8_t> header_bytes;
+    header_bytes.reserve(block_count * BLOCK_HEADER_SIZE);
+    {
+        BodyStoreWriter writer(path);
+        Block parent = makeGenesisBlock();
+        writer.add(parent);
+        std::vector<Transaction> txs(tx_per_block);
+        for (size_t b = 1; b <= block_count; ++b) {
+            for (size_t i = 0; i < tx_per_block; ++i) {
+                txs[i] = pool[(b * tx_per_block + i) % TX_POOL];
+            }
+            Block block = ForkTree::createBlock(parent, txs, b);
+            writer.add(block);
+            std::vector<uint8_t> h = serializeBlockHeader(blockHeaderOf(block));
+            header_bytes.insert(header_bytes.end(), h.begin(), h.end());
+            parent.index = block.index;
+            parent.block_hash = block.block_hash;
+        }
+        writer.finish();
+    }
+    auto t2 = nowMicros();
+    auto store = BodyStore::open(path);
+    std::cout << "[Build] " << block_count << " blocks in " << (t2 - t1) / 1000 << " ms; headers "
+              << std::fixed << std::setprecision(1) << mb(header_bytes.size()) << " MB, bodies "
+              << mb(store->fileSize()) << " MB in " << path << "\n\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    // 2. Header sync: decode + link + hash check, no transaction data.
+    size_t rss0 = currentRssBytes();
+    t1 = nowMicros();
+    HeaderChain headers;
+    headers.reserve(block_count + 1);
+    for (size_t off = 0; off < header_bytes.size(); off += BLOCK_HEADER_SIZE) {
+        if (!headers.append(deserializeBlockHeader(header_bytes.data() + off, BLOCK_HEADER_SIZE))) {
+            std::cerr << "Header chain rejected header " << headers.size() << "\n";
+            return 1;
+        }
+    }
+    t2 = nowMicros();
+    uint64_t header_us = t2 - t1;
+    long long header_rss = rssDelta(rss0);
+
+    // 3. On demand: random bodies, and an ancestry walk from tip to genesis
+    //    through the hash index.
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<uint32_t> pick(1, static_cast<uint32_t>(block_count));
+    t1 = nowMicros();
+    size_t loaded_txs = 0;
+    for (size_t i = 0; i < RANDOM_LOADS; ++i) {
+        loaded_txs += headers.loadBlock(pick(rng), *store).transactions.size();
+    }
+    t2 = nowMicros();
+    double load_us = static_cast<double>(t2 - t1) / RANDOM_LOADS;
+
+    t1 = nowMicros();
+    uint32_t height = headers.tip().index;
+    size_t steps = 0;
+    while (height > 0 && headers.find(headers.at(height).prev_hash, height)) {
+        ++steps;
+    }
+    t2 = nowMicros();
+    uint64_t walk_us = t2 - t1;
+    bool walk_ok = steps == block_count && height == 0;
+
+    // 4. Full sync: every Block decoded from the store and held by a
+    //    Blockchain (no witness pruning). RSS is read after the store is
+    //    unmapped, so only the heap is counted.
+    rss0 = currentRssBytes();
+    t1 = nowMicros();
+    Blockchain chain(crypto);
+    bool full_ok = true;
+    for (uint32_t h = 1; h <= block_count && full_ok; ++h) {
+        full_ok = chain.appendPreverifiedBlock(headers.loadBlock(h, *store));
+    }
+    t2 = nowMicros();
+    uint64_t full_us = t2 - t1;
+    store.reset();
+    long long full_rss = rssDelta(rss0);
+    std::remove(path.c_str());
+    if (!full_ok) {
+        std::cerr << "Blockchain rejected block " << chain.latestBlock().index + 1 << "\n";
+        return 1;
+    }
+
+    size_t full_footprint = 0;
+    for (const auto& b : chain.blocks()) {
+        full_footprint += blockMemoryFootprint(b);
+    }
+    size_t header_footprint = headers.memoryFootprint();
+
+    std::cout << std::left << std::setw(14) << "sync" << std::right
+              << std::setw(12) << "time_ms" << std::setw(14) << "blocks/s"
+              << std::setw(13) << "rss_MB" << std::setw(15) << "footprint_MB"
+              << std::setw(13) << "bytes/blk" << "\n";
+    struct Row {
+        const char* what;
+        uint64_t us;
+        long long rss;
+        size_t footprint;
+    };
+    for (const Row& r : {Row{"headers", header_us, header_rss, header_footprint},
+                         Row{"full blocks", full_us, full_rss, full_footprint}}) {
+        std::cout << std::left << std::setw(14) << r.what << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << r.us / 1000.0
+                  << std::setw(14) << (r.us ? block_count * 1e6 / r.us : 0.0)
+                  << std::setw(13) << mb(static_cast<double>(r.rss))
+                  << std::setw(15) << mb(r.footprint)
+                  << std::setw(13) << std::setprecision(0)
+                  << static_cast<double>(r.footprint) / (block_count + 1) << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << std::fixed << std::setprecision(1)
+              << "\n[Ratio] headers use " << (header_footprint ? static_cast<double>(full_footprint) / header_footprint : 0.0)
+              << "x less memory and sync " << (header_us ? static_cast<double>(full_us) / header_us : 0.0)
+              << "x faster than full blocks\n";
+    std::cout << "[On demand] " << RANDOM_LOADS << " random body loads: " << std::setprecision(2)
+              << load_us << " us each (" << loaded_txs << " txs, checked against body_root)\n";
+    std::cout << "[Ancestry] tip -> genesis via hash index: " << steps << " steps in "
+              << walk_us / 1000.0 << " ms" << (walk_ok ? "" : " (INCOMPLETE)") << "\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    return walk_ok ? 0 : 1;
+}
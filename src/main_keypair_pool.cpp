@@ -0,0 +1,102 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "keypair_pool.h"
+#include "timing.h"
+#include "wallet.h"
+
+// Wallet-creation latencies for one scenario, over all bursts.
+static void printLatencies(const std::string& label, const std::vector<uint64_t>& lat) {
+    uint64_t total = 0;
+    for (auto v : lat) total += v;
+    double avg = lat.empty() ? 0.0 : static_cast<double>(total) / lat.size();
+
+    std::cout << "[" << label << "] wallets: " << lat.size()
+              << "  avg: " << avg << " us"
+              << "  p50: " << percentileMicros(lat, 50) << " us"
+              << "  p90: " << percentileMicros(lat, 90) << " us"
+              << "  p99: " << percentileMicros(lat, 99) << " us"
+              << "  max: " << percentileMicros(lat, 100) << " us\n";
+}
+
+static void printPoolStats(const std::string& label, const KeypairPoolStats& s) {
+    double avg_keygen_us = s.generated
+        ? static_cast<double>(s.keygen_total_us) / s.generated : 0.0;
+    std::cout << "[" << label << "] pool hits: " << s.hits
+              << "  misses: " << s.misses
+              << "  hit rate: " << s.hitRate() * 100.0 << " %\n";
+    std::cout << "[" << label << "] refill: " << s.generated << " keypairs, "
+              << s.refillPerSecond() << " keypairs/s, "
+              << avg_keygen_us << " us avg keygen per worker\n";
+}
+
+int main() {
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    const size_t BURSTS = 5;
+    const size_t BURST_SIZE = 64;      // wallets requested back-to-back
+    const size_t POOL_CAPACITY = 32;   // deliberately smaller than a burst
+    const auto BURST_GAP = std::chrono::milliseconds(200);
+    size_t workers = std::thread::hardware_concurrency();
+    workers = std::max<size_t>(1, std::min<size_t>(4, workers > 1 ? workers - 1 : 1));
+
+    std::cout << "=== Keypair pool benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << ")\n";
+    std::cout << "Bursts: " << BURSTS << " x " << BURST_SIZE << " wallets, "
+              << BURST_GAP.count() << " ms apart\n";
+    std::cout << "Pool capacity: " << POOL_CAPACITY
+              << ", refill workers: " << workers << "\n\n";
+
+    // 1. Baseline: generateKeypair inline in the caller.
+    {
+        std::vector<uint64_t> lat;
+        for (size_t b = 0; b < BURSTS; ++b) {
+            for (size_t i = 0; i < BURST_SIZE; ++i) {
+                Wallet w(crypto);
+                auto t1 = nowMicros();
+                w.generateNewKeypair();
+                auto t2 = nowMicros();
+                lat.push_back(t2 - t1);
+            }
+            std::this_thread::sleep_for(BURST_GAP);
+        }
+        printLatencies("Inline", lat);
+        std::cout << "\n";
+    }
+
+    // 2. Pool, non-blocking take with inline fallback on a miss.
+    // 3. Pool, blocking take.
+    for (bool blocking : {false, true}) {
+        std::string label = blocking ? "Pool/blocking" : "Pool/fallback";
+        KeypairPool pool(cfg, POOL_CAPACITY, workers);
+        pool.waitUntilFull();
+
+        std::vector<uint64_t> lat;
+        for (size_t b = 0; b < BURSTS; ++b) {
+            for (size_t i = 0; i < BURST_SIZE; ++i) {
+                Wallet w(crypto);
+                auto t1 = nowMicros();
+                w.generateNewKeypair(pool, blocking);
+                auto t2 = nowMicros();
+                lat.push_back(t2 - t1);
+            }
+            std::this_thread::sleep_for(BURST_GAP);
+        }
+        printLatencies(label, lat);
+        printPoolStats(label, pool.stats());
+        std::cout << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "timing.h"
+#include "wallet.h"
+#include "keystore.h"
+#include "mem_accounting.h"
+#include "thread_affinity.h"
+
+// Usage: crypto_keystore.exe [keystore_file] [count] [threads]
+// If 'keystore_file' does not exist, 'count' keys of the selected
+// algorithm are generated into it first (on 'threads' workers).
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "keystore.bin";
+    size_t count = argc > 2 ? static_cast<size_t>(std::atoll(argv[2])) : 2000;
+    unsigned threads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 0;
+    if (threads == 0) {
+        threads = hardwareThreadCount();
+    }
+    const size_t SIGN_WALLETS = 200;
+    const size_t REGEN_SAMPLE = 20;
+
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    std::cout << "=== Keystore benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << ")\n";
+
+    // 1. Generate if missing.
+    bool exists = static_cast<bool>(std::ifstream(path, std::ios::binary));
+    if (!exists) {
+        std::cout << "[Generate] " << count << " keypairs on " << threads << " thread(s)...\n";
+        KeystoreGenStats g = Keystore::generate(path, cfg, count, threads);
+        std::cout << "[Generate] " << g.elapsed_us << " us ("
+                  << std::fixed << std::setprecision(1) << g.keysPerSecond()
+                  << " keys/s), saved to " << path << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    // 2. Open: only the header is parsed, records are paged in on use.
+    size_t rss_before = currentRssBytes();
+    auto t1 = nowMicros();
+    std::shared_ptr<const Keystore> store = Keystore::open(path);
+    auto t2 = nowMicros();
+    size_t rss_after = currentRssBytes();
+    if (store->scheme() != crypto->schemeId()) {
+        std::cerr << "Keystore holds keys of another algorithm (scheme id "
+                  << static_cast<int>(store->scheme()) << "); delete " << path << "\n";
+        return 1;
+    }
+    std::cout << "[Open] " << store->size() << " keys, " << store->fileSize()
+              << " bytes mapped in " << (t2 - t1) << " us (RSS +"
+              << (rss_after > rss_before ? (rss_after - rss_before) / 1024 : 0) << " KB)\n";
+
+    // What loading the same keys used to cost: regenerating them.
+    auto t3 = nowMicros();
+    for (size_t i = 0; i < REGEN_SAMPLE; ++i) {
+        crypto->generateKeypair();
+    }
+    auto t4 = nowMicros();
+    double regen_us = static_cast<double>(t4 - t3) / REGEN_SAMPLE * store->size();
+    std::cout << "[Open] Regenerating them on one thread would take ~"
+              << std::fixed << std::setprecision(0) << regen_us << " us ("
+              << std::setprecision(1) << (t2 > t1 ? regen_us / (t2 - t1) : 0.0) << "x the open)\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    // 3. Index lookups: every account id must map back to its record.
+    bool all_ok = true;
+    std::vector<AccountId> ids;
+    ids.reserve(store->size());
+    for (size_t i = 0; i < store->size(); ++i) {
+        ids.push_back(store->entry(i).accountId());
+    }
+    auto t5 = nowMicros();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        size_t found = 0;
+        all_ok = all_ok && store->find(ids[i], found) && found == i;
+    }
+    auto t6 = nowMicros();
+    AccountId missing{};
+    size_t unused = 0;
+    all_ok = all_ok && (store->size() == 0 || !store->find(missing, unused));
+    std::cout << "[Lookup] " << ids.size() << " finds in " << (t6 - t5) << " us ("
+              << std::fixed << std::setprecision(3)
+              << (ids.empty() ? 0.0 : static_cast<double>(t6 - t5) / ids.size())
+              << " us each): " << (all_ok ? "all matched" : "MISMATCH") << "\n";
+    std::cout.unsetf(std::ios::fixed);
+
+    // 4. Wallets bound to entries sign from the mapping in place.
+    size_t wallets = std::min(SIGN_WALLETS, store->size());
+    Wallet receiver(crypto);
+    receiver.generateNewKeypair();
+    size_t verified = 0;
+    auto t7 = nowMicros();
+    std::vector<Transaction> txs;
+    for (size_t i = 0; i < wallets; ++i) {
+        Wallet w(crypto);
+        w.bindKeystoreEntry(store, i);
+        txs.push_back(w.createTransaction(receiver.publicKey(), 1, 1));
+    }
+    auto t8 = nowMicros();
+    for (const auto& tx : txs) {
+        verified += crypto->verify(txSigningMessage(tx), tx.signature, tx.from_pubkey) ? 1 : 0;
+    }
+    all_ok = all_ok && verified == wallets;
+    std::cout << "[Sign] " << wallets << " bound wallets, one tx each, in " << (t8 - t7)
+              << " us; " << verified << "/" << wallets << " signatures verify\n";
+
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+
+#include "algo_config.h"
+#include "crypto_registry.h"
+#include "crypto.h"
+#include "timing.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "transaction.h"
+
+// Share of a block's transactions signed by each backend (percent).
+struct SchemeMix {
+    const char* label;
+    std::vector<unsigned> percent; // one entry per backend, sums to 100
+};
+
+int main() {
+    // 1. One backend per family; these are the accounts that coexist
+    //    during migration.
+    std::vector<AlgoConfig> cfgs = {
+        {AlgoFamily::FALCON, "512"},
+        {AlgoFamily::ML_DSA, "44"},
+        {AlgoFamily::HAWK, "512"},
+    };
+    CryptoRegistry registry = CryptoRegistry::fromConfigs(cfgs);
+    std::vector<SchemeId> ids;
+    for (const auto& cfg : cfgs) {
+        ids.push_back(schemeIdFor(cfg));
+    }
+
+    std::cout << "=== Mixed-scheme blockchain benchmark ===\n";
+    std::cout << "Backends:";
+    for (SchemeId id : ids) {
+        std::cout << " " << registry.get(id)->name();
+    }
+    std::cout << "\n\n";
+
+    // 2. One sender wallet per scheme; Bob receives everything.
+    std::vector<Wallet> senders;
+    for (SchemeId id : ids) {
+        senders.emplace_back(registry.get(id));
+        senders.back().generateNewKeypair();
+    }
+    const std::vector<uint8_t>& bob_pk = senders.front().publicKey();
+
+    const size_t TX_PER_BLOCK = 1000;
+    const size_t BLOCK_VERIFY_ITERS = 20;
+
+    std::vector<SchemeMix> mixes = {
+        {"100/0/0",  {100, 0, 0}},
+        {"0/100/0",  {0, 100, 0}},
+        {"0/0/100",  {0, 0, 100}},
+        {"50/50/0",  {50, 50, 0}},
+        {"50/0/50",  {50, 0, 50}},
+        {"0/50/50",  {0, 50, 50}},
+        {"34/33/33", {34, 33, 33}},
+        {"80/10/10", {80, 10, 10}},
+    };
+
+    std::cout << "Transactions per block: " << TX_PER_BLOCK << "\n";
+    std::cout << "Mix columns are percent of txs per backend, in the order above.\n\n";
+    std::cout << std::left << std::setw(10) << "mix" << std::right
+              << std::setw(14) << "block_bytes"
+              << std::setw(14) << "avg_tx_bytes"
+              << std::setw(14) << "validate_us"
+              << std::setw(18) << "verify_per_tx_us" << "\n";
+
+    std::mt19937_64 rng(42);
+
+    for (const auto& mix : mixes) {
+        // 3. Pick which sender signs each tx, then shuffle so schemes are
+        //    interleaved inside the block (validation has to regroup them).
+        std::vector<size_t> who;
+        for (size_t s = 0; s < ids.size(); ++s) {
+            size_t n = TX_PER_BLOCK * mix.percent[s] / 100;
+            who.insert(who.end(), n, s);
+        }
+        while (who.size() < TX_PER_BLOCK) {
+            who.push_back(0);
+        }
+        std::shuffle(who.begin(), who.end(), rng);
+
+        std::vector<Transaction> txs;
+        txs.reserve(TX_PER_BLOCK);
+        for (size_t i = 0; i < who.size(); ++i) {
+            txs.push_back(senders[who[i]].createTransaction(bob_pk, i + 1, i + 1));
+        }
+
+        // 4. Build the block on a fresh chain and validate it repeatedly.
+        Blockchain chain(registry);
+        Block block = chain.createBlockWithTransactions(txs);
+        size_t block_size_bytes = serializeFullBlock(block).size();
+
+        if (!chain.validateBlock(block)) {
+            std::cerr << "Block validation failed for mix " << mix.label << "\n";
+            return 1;
+        }
+
+        uint64_t total_us = 0;
+        for (size_t i = 0; i < BLOCK_VERIFY_ITERS; ++i) {
+            auto t1 = nowMicros();
+            bool ok = chain.validateBlock(block);
+            auto t2 = nowMicros();
+            if (!ok) {
+                std::cerr << "Block validation FAILED at iteration " << i << "\n";
+                return 1;
+            }
+            total_us += (t2 - t1);
+        }
+
+        double validate_avg_us = static_cast<double>(total_us) / BLOCK_VERIFY_ITERS;
+        std::cout << std::left << std::setw(10) << mix.label << std::right
+                  << std::setw(14) << block_size_bytes
+                  << std::setw(14) << static_cast<double>(block_size_bytes) / TX_PER_BLOCK
+                  << std::setw(14) << validate_avg_us
+                  << std::setw(18) << validate_avg_us / TX_PER_BLOCK << "\n";
+    }
+
+    // 5. A tx whose scheme tag is not registered must be rejected.
+    {
+        CryptoRegistry falcon_only;
+        falcon_only.add(registry.get(ids[0]));
+        Blockchain chain(falcon_only);
+        std::vector<Transaction> txs = {senders[1].createTransaction(bob_pk, 1, 1)};
+        Block block = chain.createBlockWithTransactions(txs);
+        bool ok = chain.validateBlock(block);
+        std::cout << "\n[Unregistered scheme] validateBlock result: "
+                  << (ok ? "OK (unexpected!)" : "FAIL (as expected)") << "\n";
+    }
+
+    return 0;
+}
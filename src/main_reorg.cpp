@@ -0,0 +1,145 @@
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "timing.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "crypto_registry.h"
+#include "fork_tree.h"
+
+// 'count' blocks on top of 'parent', each with 'tx_per_block' txs from
+// 'sender' (nonces continue from 'nonce'). Blocks are only created here.
+static std::vector<Block> buildBranch(Block parent,
+                                      const Wallet& sender, const std::vector<uint8_t>& to,
+                                      size_t count, size_t tx_per_block,
+                                      uint64_t& nonce, uint64_t timestamp_base) {
+    std::vector<Block> out;
+    for (size_t b = 0; b < count; ++b) {
+        std::vector<Transaction> txs;
+        for (size_t i = 0; i < tx_per_block; ++i, ++nonce) {
+            txs.push_back(sender.createTransaction(to, 1, nonce));
+        }
+        out.push_back(ForkTree::createBlock(parent, txs, timestamp_base + parent.index + 1));
+        parent = out.back();
+    }
+    return out;
+}
+
+int main() {
+    std::vector<size_t> depths = {1, 2, 4, 8, 16};
+    std::vector<size_t> block_sizes = {10, 50, 200};
+
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    std::cout << "=== Fork tree reorg benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << ")\n";
+    std::cout << "Branch A (depth blocks) is the tip; branch B (depth+1 blocks) from\n"
+                 "genesis then takes over. reorg_us covers disconnect + reconnect only;\n"
+                 "reverify_us is what re-checking the new branch's signatures would add.\n\n";
+
+    CryptoRegistry registry;
+    registry.add(crypto);
+
+    Wallet alice(crypto), carol(crypto), bob(crypto);
+    alice.generateNewKeypair();
+    carol.generateNewKeypair();
+    bob.generateNewKeypair();
+
+    std::cout << std::setw(7) << "depth" << std::setw(10) << "tx/block"
+              << std::setw(12) << "reorg_us" << std::setw(14) << "us/block"
+              << std::setw(14) << "reverify_us" << std::setw(13) << "sigs_in_add" << "\n";
+
+    bool all_ok = true;
+    for (size_t tx_per_block : block_sizes) {
+        for (size_t depth : depths) {
+            ForkTree tree(crypto, ForkChoice::LONGEST);
+            uint64_t nonce_a = 1, nonce_b = 1;
+            std::vector<Block> a = buildBranch(tree.genesis(), alice, bob.publicKey(),
+                                               depth, tx_per_block, nonce_a, 0);
+            std::vector<Block> b = buildBranch(tree.genesis(), carol, bob.publicKey(),
+                                               depth + 1, tx_per_block, nonce_b, 1000000);
+
+            for (const auto& blk : a) {
+                all_ok = all_ok && tree.addBlock(blk).status == AddBlockStatus::ADDED_TO_TIP;
+            }
+            for (size_t i = 0; i + 1 < b.size(); ++i) {
+                all_ok = all_ok && tree.addBlock(b[i]).status == AddBlockStatus::SIDE_BRANCH;
+            }
+
+            uint64_t sigs_before = tree.signaturesVerified();
+            AddBlockResult r = tree.addBlock(b.back());
+            uint64_t sigs_in_add = tree.signaturesVerified() - sigs_before;
+            bool ok = r.status == AddBlockStatus::REORGED &&
+                      r.reorg.disconnected == depth && r.reorg.connected == depth + 1 &&
+                      tree.tip().block_hash == b.back().block_hash &&
+                      tree.state().account(accountIdFor(alice.publicKey())).nonce == 0 &&
+                      tree.state().account(accountIdFor(carol.publicKey())).nonce == nonce_b - 1;
+            all_ok = all_ok && ok;
+
+            // For comparison: re-verifying the connected branch.
+            auto t1 = nowMicros();
+            for (const auto& blk : b) {
+                verifyBlockSignatures(registry, blk);
+            }
+            auto t2 = nowMicros();
+
+            std::cout << std::setw(7) << depth << std::setw(10) << tx_per_block
+                      << std::setw(12) << r.reorg.elapsed_us
+                      << std::setw(14) << std::fixed << std::setprecision(1)
+                      << static_cast<double>(r.reorg.elapsed_us) / (2 * depth + 1)
+                      << std::setw(14) << (t2 - t1)
+                      << std::setw(13) << sigs_in_add
+                      << (ok ? "" : "  UNEXPECTED") << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+
+    // A block that replays nonces must not become the tip.
+    {
+        ForkTree tree(crypto);
+        uint64_t nonce = 1;
+        std::vector<Block> a = buildBranch(tree.genesis(), alice, bob.publicKey(), 1, 5, nonce, 0);
+        tree.addBlock(a[0]);
+        uint64_t replay = 1; // reuses nonces 1.. from alice's first block
+        std::vector<Block> b = buildBranch(a[0], alice, bob.publicKey(), 1, 5, replay, 0);
+        AddBlockResult r = tree.addBlock(b[0]);
+        bool rejected = r.status == AddBlockStatus::INVALID && tree.tip().block_hash == a[0].block_hash;
+        std::cout << "\n[State] Block replaying nonces on top of the tip: "
+                  << (rejected ? "rejected, tip unchanged (as expected)" : "ACCEPTED (unexpected!)") << "\n";
+        all_ok = all_ok && rejected;
+    }
+
+    // Amounts past INT64_MAX, and transfers that overflow a balance, must
+    // be rejected too (and leave the ledger as it was).
+    {
+        const uint64_t max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+        std::vector<std::vector<Transaction>> cases = {
+            {alice.createTransaction(bob.publicKey(), max + 1, 1)},
+            {alice.createTransaction(bob.publicKey(), max, 1),
+             alice.createTransaction(bob.publicKey(), max, 2)},
+        };
+        bool rejected = true;
+        for (const auto& txs : cases) {
+            ForkTree tree(crypto);
+            AddBlockResult r = tree.addBlock(ForkTree::createBlock(tree.genesis(), txs, 1));
+            rejected = rejected && r.status == AddBlockStatus::INVALID &&
+                       tree.state().account(accountIdFor(alice.publicKey())).nonce == 0 &&
+                       tree.state().accountCount() == 0;
+        }
+        std::cout << "[State] Amount above INT64_MAX / balance overflow: "
+                  << (rejected ? "rejected, state unchanged (as expected)" : "ACCEPTED (unexpected!)") << "\n";
+        all_ok = all_ok && rejected;
+    }
+
+    return all_ok ? 0 : 1;
+}
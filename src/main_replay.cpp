@@ -0,0 +1,150 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "timing.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "chain_replay.h"
+#include "thread_affinity.h"
+
+// Usage: crypto_replay.exe [chain_file] [max_threads]
+// If 'chain_file' exists its blocks are replayed; otherwise a chain is
+// built with the selected algorithm and saved there first.
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "chain.bin";
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 0;
+    if (max_threads == 0) {
+        max_threads = hardwareThreadCount();
+    }
+
+    const size_t BLOCK_COUNT = 40;
+    const size_t TX_PER_BLOCK = 250;
+
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    std::cout << "=== Parallel chain replay benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << ")\n";
+
+    // 1. Load or build + save.
+    bool exists = static_cast<bool>(std::ifstream(path, std::ios::binary));
+    if (!exists) {
+        std::cout << "[Chain] Building " << BLOCK_COUNT << " blocks x "
+                  << TX_PER_BLOCK << " tx...\n";
+        Blockchain producer(crypto);
+        Wallet alice(crypto);
+        Wallet bob(crypto);
+        alice.generateNewKeypair();
+        bob.generateNewKeypair();
+
+        uint64_t nonce = 1;
+        for (size_t b = 0; b < BLOCK_COUNT; ++b) {
+            std::vector<Transaction> txs;
+            for (size_t i = 0; i < TX_PER_BLOCK; ++i, ++nonce) {
+                txs.push_back(alice.createTransaction(bob.publicKey(), nonce, nonce));
+            }
+            if (!producer.appendBlock(producer.createBlockWithTransactions(txs))) {
+                std::cerr << "Producer rejected its own block\n";
+                return 1;
+            }
+        }
+        std::vector<Block> blocks(producer.blocks().begin() + 1, producer.blocks().end());
+        saveChainFile(path, blocks);
+        std::cout << "[Chain] Saved to " << path << "\n";
+    }
+
+    auto t1 = nowMicros();
+    std::vector<std::vector<uint8_t>> serialized = loadChainFile(path);
+    auto t2 = nowMicros();
+    size_t bytes = 0;
+    for (const auto& s : serialized) {
+        bytes += s.size();
+    }
+    std::cout << "[Chain] Loaded " << serialized.size() << " blocks (" << bytes
+              << " bytes) from " << path << " in " << (t2 - t1) << " us\n\n";
+
+    // 2. Replay at increasing thread counts; 0 = sequential appendBlock.
+    std::vector<unsigned> counts = {0};
+    for (unsigned t = 1; t <= max_threads; t *= 2) {
+        counts.push_back(t);
+    }
+    if (counts.back() != max_threads) {
+        counts.push_back(max_threads);
+    }
+
+    std::cout << std::setw(9) << "threads" << std::setw(12) << "blocks/s"
+              << std::setw(12) << "tx/s" << std::setw(10) << "speedup" << "\n";
+
+    double base = 0.0;
+    for (unsigned t : counts) {
+        Blockchain chain(crypto);
+        ReplayResult r = replayChain(chain, serialized, t);
+        if (!r.ok) {
+            std::cerr << "Replay failed at block " << r.failed_at
+                      << " (chain file built with another algorithm?)\n";
+            return 1;
+        }
+        if (t == 0) {
+            base = r.txPerSecond();
+        }
+        std::cout << std::setw(9) << (t == 0 ? std::string("seq") : std::to_string(t))
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << r.blocksPerSecond()
+                  << std::setw(12) << r.txPerSecond()
+                  << std::setw(9) << std::setprecision(2)
+                  << (base > 0 ? r.txPerSecond() / base : 0.0) << "x\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    // 3. A bad signature in the middle must stop the replay at that block,
+    //    with everything before it committed.
+    if (serialized.size() > 2) {
+        std::vector<std::vector<uint8_t>> bad = serialized;
+        size_t victim = serialized.size() / 2;
+        bad[victim][bad[victim].size() - 1] ^= 0x01; // last byte = last tx's signature
+
+        Blockchain chain(crypto);
+        ReplayResult r = replayChain(chain, bad, max_threads);
+        bool as_expected = !r.ok && r.failed_at == victim && r.blocks == victim;
+        std::cout << "\n[Tamper] Flipped a signature bit in block " << victim + 1
+                  << ": replay stopped at input " << r.failed_at
+                  << (as_expected ? " (as expected)" : " (UNEXPECTED)") << "\n";
+        if (!as_expected) {
+            return 1;
+        }
+    }
+
+    // 4. A decoded tx can carry a key of any length. A 1-byte from_pubkey
+    //    must be rejected by every backend, not read past its end.
+    for (const auto& c : allAlgorithms()) {
+        auto backend = createCrypto(c);
+        Wallet w(backend);
+        w.generateNewKeypair();
+        Transaction tx = w.createTransaction(w.publicKey(), 1, 1);
+        tx.from_pubkey.resize(1);
+        clearTxEncoding(tx);
+
+        Blockchain chain(backend);
+        std::vector<uint8_t> data = serializeFullBlock(chain.createBlockWithTransactions({tx}));
+        bool rejected = !chain.appendBlock(deserializeFullBlock(data)) &&
+                        !replayChain(chain, {data}, max_threads).ok;
+        std::cout << "[Short key] " << backend->name() << ": 1-byte public key "
+                  << (rejected ? "rejected" : "ACCEPTED") << "\n";
+        if (!rejected) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "metrics.h"
+#include "timing.h"
+#include "randomness.h"
+
+struct ModeRow {
+    const char* label;
+    RngMode mode;
+};
+
+// Operations per second of 'iters' calls of fn.
+template <typename Fn>
+static double rate(size_t iters, Fn&& fn) {
+    auto t1 = nowMicros();
+    for (size_t i = 0; i < iters; ++i) {
+        fn();
+    }
+    auto t2 = nowMicros();
+    return t2 > t1 ? iters * 1e6 / (t2 - t1) : 0.0;
+}
+
+int main() {
+    const size_t KEYGEN_ITERS = 200;
+    const size_t SIGN_ITERS = 1000;
+    const uint64_t SEED = 42;
+
+    setMetricsEnabled(false);
+
+    std::vector<ModeRow> modes = {
+        {"system", RngMode::SYSTEM},
+        {"buffered", RngMode::BUFFERED},
+        {"deterministic", RngMode::DETERMINISTIC},
+    };
+
+    std::cout << "=== Randomness provider benchmark ===\n";
+    std::cout << "liboqs (randombytes hook) and Hawk (rng callback) both draw from\n"
+                 "randomness.h; system = one OS call per draw.\n\n";
+
+    // 1. Raw cost of a draw.
+    std::cout << std::left << std::setw(15) << "mode" << std::right
+              << std::setw(14) << "ns/32B draw" << std::setw(14) << "MB/s @32B"
+              << std::setw(14) << "MB/s @4KB" << "\n";
+    for (const auto& m : modes) {
+        setRngMode(m.mode, SEED);
+        RngCost small = measureRngCost(32, 20000);
+        RngCost large = measureRngCost(4096, 2000);
+        std::cout << std::left << std::setw(15) << m.label << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(14) << small.ns_per_draw
+                  << std::setw(14) << small.mb_per_second
+                  << std::setw(14) << large.mb_per_second << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    // 2. What the mode does to keygen and sign throughput.
+    std::cout << "\n" << std::left << std::setw(13) << "algorithm" << std::setw(15) << "mode"
+              << std::right << std::setw(12) << "keygen/s" << std::setw(12) << "sign/s" << "\n";
+    for (const auto& cfg : allAlgorithms()) {
+        auto crypto = createCrypto(cfg);
+        for (const auto& m : modes) {
+            setRngMode(m.mode, SEED);
+            double keygen = rate(KEYGEN_ITERS, [&] { crypto->generateKeypair(); });
+            auto [pk, sk] = crypto->generateKeypair();
+            std::vector<uint8_t> msg(64, 0x5A);
+            double sign = rate(SIGN_ITERS, [&] { crypto->sign(msg, sk); });
+            std::cout << std::left << std::setw(13) << crypto->name() << std::setw(15) << m.label
+                      << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(12) << keygen << std::setw(12) << sign << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+
+    bool all_ok = true;
+
+    // 3. Same seed, same keys; a different seed, different keys.
+    std::cout << "\n[Determinism] keypair from seed " << SEED << " twice / seed " << SEED + 1 << ":\n";
+    for (const auto& cfg : allAlgorithms()) {
+        auto crypto = createCrypto(cfg);
+        setRngMode(RngMode::DETERMINISTIC, SEED);
+        auto a = crypto->generateKeypair();
+        setRngMode(RngMode::DETERMINISTIC, SEED);
+        auto b = crypto->generateKeypair();
+        setRngMode(RngMode::DETERMINISTIC, SEED + 1);
+        auto c = crypto->generateKeypair();
+        bool ok = a == b && a.first != c.first;
+        all_ok = all_ok && ok;
+        std::cout << "  " << std::left << std::setw(13) << crypto->name() << std::right
+                  << (ok ? "repeatable" : "NOT REPEATABLE") << "\n";
+    }
+
+    // 4. One Hawk instance signing from several threads at once.
+    setRngMode(RngMode::BUFFERED);
+    {
+        auto hawk = createCrypto({AlgoFamily::HAWK, "512"});
+        auto [pk, sk] = hawk->generateKeypair();
+        std::atomic<size_t> bad{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 100; ++i) {
+                    std::vector<uint8_t> msg = {static_cast<uint8_t>(t), static_cast<uint8_t>(i)};
+                    if (!hawk->verify(msg, hawk->sign(msg, sk), pk)) {
+                        ++bad;
+                    }
+                }
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        std::cout << "\n[Threads] Shared Hawk-512 instance, 4 threads x 100 signs: "
+                  << (bad == 0 ? "all verify" : "FAILURES") << "\n";
+        all_ok = all_ok && bad == 0;
+    }
+
+    return all_ok ? 0 : 1;
+}
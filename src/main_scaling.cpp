@@ -0,0 +1,177 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "metrics.h"
+#include "thread_affinity.h"
+#include "timing.h"
+
+enum class ScalingOp { KEYGEN, SIGN, VERIFY };
+
+static const char* opName(ScalingOp op) {
+    switch (op) {
+    case ScalingOp::KEYGEN: return "keygen";
+    case ScalingOp::SIGN:   return "sign";
+    case ScalingOp::VERIFY: return "verify";
+    }
+    return "?";
+}
+
+struct ScalingPoint {
+    uint64_t ops = 0;
+    uint64_t elapsed_us = 0;
+    bool pinned = true; // all workers pinned successfully (if pinning was asked)
+
+    double opsPerSecond() const {
+        return elapsed_us ? ops * 1e6 / elapsed_us : 0.0;
+    }
+};
+
+// Run 'threads' independent workers for 'duration_us'. Each worker owns its
+// backend, keypair and message, so the only shared resources are the
+// hardware ones (cores, caches, memory bandwidth).
+static ScalingPoint runPoint(const AlgoConfig& cfg, ScalingOp op, unsigned threads,
+                             uint64_t duration_us, bool pin) {
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    std::atomic<uint64_t> total_ops{0};
+    std::atomic<bool> all_pinned{true};
+    std::atomic<bool> failed{false};
+    uint64_t start_us = 0;
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            if (pin && !pinCurrentThreadToCpu(t)) {
+                all_pinned = false;
+            }
+
+            // Setup (not timed).
+            auto crypto = createCrypto(cfg);
+            auto kp = crypto->generateKeypair();
+            std::vector<uint8_t> msg(64, static_cast<uint8_t>(t));
+            std::vector<uint8_t> sig = crypto->sign(msg, kp.second);
+
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            uint64_t ops = 0;
+            uint64_t deadline = start_us + duration_us;
+            do {
+                switch (op) {
+                case ScalingOp::KEYGEN:
+                    crypto->generateKeypair();
+                    break;
+                case ScalingOp::SIGN:
+                    crypto->sign(msg, kp.second);
+                    break;
+                case ScalingOp::VERIFY:
+                    if (!crypto->verify(msg, sig, kp.first)) {
+                        failed = true;
+                    }
+                    break;
+                }
+                ++ops;
+            } while (nowMicros() < deadline);
+
+            total_ops.fetch_add(ops);
+        });
+    }
+
+    while (ready.load() < threads) {
+        std::this_thread::yield();
+    }
+    start_us = nowMicros();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) {
+        w.join();
+    }
+    uint64_t end_us = nowMicros();
+
+    if (failed) {
+        std::cerr << "Verify failed during scaling run\n";
+        std::exit(1);
+    }
+
+    ScalingPoint p;
+    p.ops = total_ops.load();
+    p.elapsed_us = end_us - start_us;
+    p.pinned = !pin || all_pinned.load();
+    return p;
+}
+
+// Usage: crypto_scaling.exe [max_threads] [duration_ms] [pin|nopin] [csv_path]
+int main(int argc, char** argv) {
+    unsigned max_threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 0;
+    if (max_threads == 0) {
+        max_threads = hardwareThreadCount();
+    }
+    uint64_t duration_ms = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 300;
+    bool pin = argc > 3 && std::string(argv[3]) == "pin";
+    std::string csv_path = argc > 4 ? argv[4] : "scaling.csv";
+
+    // Latency histograms are shared per algorithm; keep their atomics out
+    // of the measurement.
+    setMetricsEnabled(false);
+
+    std::cout << "=== Core-count scaling benchmark ===\n";
+    std::cout << "Threads: 1.." << max_threads
+              << " (hardware threads: " << hardwareThreadCount() << ")\n";
+    std::cout << "Duration per point: " << duration_ms << " ms\n";
+    std::cout << "CPU pinning: " << (pin ? "on" : "off") << "\n";
+    std::cout << "CSV output: " << csv_path << "\n\n";
+
+    std::ofstream csv(csv_path, std::ios::trunc);
+    if (!csv) {
+        std::cerr << "Cannot open " << csv_path << "\n";
+        return 1;
+    }
+    csv << "algorithm,op,threads,pinned,ops,seconds,ops_per_sec,speedup,efficiency\n";
+
+    for (const auto& cfg : allAlgorithms()) {
+        std::string alg = createCrypto(cfg)->name();
+
+        for (ScalingOp op : {ScalingOp::KEYGEN, ScalingOp::SIGN, ScalingOp::VERIFY}) {
+            std::cout << alg << " " << opName(op) << "\n";
+            std::cout << std::setw(9) << "threads" << std::setw(14) << "ops/s"
+                      << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << "\n";
+
+            double base = 0.0;
+            for (unsigned t = 1; t <= max_threads; ++t) {
+                ScalingPoint p = runPoint(cfg, op, t, duration_ms * 1000, pin);
+                double rate = p.opsPerSecond();
+                if (t == 1) {
+                    base = rate;
+                }
+                double speedup = base > 0 ? rate / base : 0.0;
+                double efficiency = speedup / t;
+
+                std::cout << std::setw(9) << t
+                          << std::setw(14) << std::fixed << std::setprecision(1) << rate
+                          << std::setw(10) << std::setprecision(2) << speedup
+                          << std::setw(12) << efficiency
+                          << (p.pinned ? "" : "  (pinning failed)") << "\n";
+                std::cout.unsetf(std::ios::fixed);
+
+                csv << alg << "," << opName(op) << "," << t << ","
+                    << (pin && p.pinned ? 1 : 0) << "," << p.ops << ","
+                    << p.elapsed_us / 1e6 << "," << rate << ","
+                    << speedup << "," << efficiency << "\n";
+            }
+            std::cout << "\n";
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include <iostream>
+#include <iomanip>
+#include <array>
+#include <memory>
+#include <vector>
+#include <string>
+#include <functional>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "metrics.h"
+#include "timing.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "block_utils.h"
+#include "transaction.h"
+
+// The serializers as they were before byte_codec.h: one push_back per
+// integer byte, no reserve, and a temporary vector per tx body. Kept here
+// only as the "before" reference and to check byte-identical output.
+namespace legacy {
+
+static void appendUint32(std::vector<uint8_t>& out, uint32_t v) {
+    for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>((v >> (8 * i)) & 0xFF));
+}
+static void appendUint64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>((v >> (8 * i)) & 0xFF));
+}
+
+static std::vector<uint8_t> txBody(const Transaction& tx) {
+    std::vector<uint8_t> out;
+    out.push_back(txSchemeTag(tx));
+    appendUint64(out, tx.from_pubkey.size());
+    out.insert(out.end(), tx.from_pubkey.begin(), tx.from_pubkey.end());
+    appendUint64(out, tx.to_pubkey.size());
+    out.insert(out.end(), tx.to_pubkey.begin(), tx.to_pubkey.end());
+    appendUint64(out, tx.amount);
+    appendUint64(out, tx.nonce);
+    return out;
+}
+
+static void headerFields(std::vector<uint8_t>& out, const Block& b) {
+    appendUint32(out, b.index);
+    out.insert(out.end(), b.prev_hash.begin(), b.prev_hash.end());
+    appendUint64(out, b.timestamp);
+}
+
+static void txBodies(std::vector<uint8_t>& out, const Block& b) {
+    appendUint64(out, b.transactions.size());
+    for (const auto& tx : b.transactions) {
+        std::vector<uint8_t> body = txBody(tx);
+        appendUint64(out, body.size());
+        out.insert(out.end(), body.begin(), body.end());
+    }
+}
+
+static std::vector<uint8_t> bodySection(const Block& b) {
+    std::vector<uint8_t> out;
+    txBodies(out, b);
+    return out;
+}
+
+static std::array<uint8_t, 32> blockHash(const Block& b) {
+    std::array<uint8_t, 32> body_root = simpleHash32(bodySection(b));
+    std::vector<uint8_t> out;
+    headerFields(out, b);
+    out.insert(out.end(), body_root.begin(), body_root.end());
+    out.insert(out.end(), b.witness_root.begin(), b.witness_root.end());
+    return simpleHash32(out);
+}
+
+static std::vector<uint8_t> witness(const Block& b) {
+    std::vector<uint8_t> out;
+    appendUint64(out, b.transactions.size());
+    for (const auto& tx : b.transactions) {
+        appendUint64(out, tx.signature.size());
+        out.insert(out.end(), tx.signature.begin(), tx.signature.end());
+    }
+    return out;
+}
+
+static std::vector<uint8_t> fullBlock(const Block& b) {
+    std::vector<uint8_t> out;
+    headerFields(out, b);
+    out.insert(out.end(), b.block_hash.begin(), b.block_hash.end());
+    out.insert(out.end(), b.witness_root.begin(), b.witness_root.end());
+    txBodies(out, b);
+    out.push_back(b.witness_pruned ? 0 : 1);
+    if (!b.witness_pruned) {
+        std::vector<uint8_t> w = witness(b);
+        out.insert(out.end(), w.begin(), w.end());
+    }
+    return out;
+}
+
+} // namespace legacy
+
+// MB/s for 'iters' calls of fn, each producing 'bytes' bytes of encoding.
+static double throughput(size_t iters, size_t bytes, const std::function<void()>& fn) {
+    auto t1 = nowMicros();
+    for (size_t i = 0; i < iters; ++i) {
+        fn();
+    }
+    auto t2 = nowMicros();
+    return t2 > t1 ? (static_cast<double>(bytes) * iters) / (t2 - t1) : 0.0; // bytes/us == MB/s
+}
+
+int main() {
+    const size_t TX_PER_BLOCK = 1000;
+    const size_t ITERS = 50;
+
+    setMetricsEnabled(false);
+
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    std::cout << "=== Serialization throughput benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name() << ", " << TX_PER_BLOCK
+              << " tx per block, " << ITERS << " iterations per row.\n";
+    std::cout << "legacy = byte-at-a-time appends; new = sized pass + presized buffer\n"
+                 "(hashes are streamed into SHA3). Block encodings always read the tx\n"
+                 "fields, never a tx's cached body.\n\n";
+
+    Blockchain chain(crypto);
+    Wallet alice(crypto), bob(crypto);
+    alice.generateNewKeypair();
+    bob.generateNewKeypair();
+    std::vector<Transaction> txs;
+    for (uint64_t i = 1; i <= TX_PER_BLOCK; ++i) {
+        txs.push_back(alice.createTransaction(bob.publicKey(), i, i));
+    }
+    Block cached = chain.createBlockWithTransactions(txs);
+    Block plain = cached;
+    for (auto& tx : plain.transactions) {
+        clearTxEncoding(tx);
+    }
+
+    // 1. Byte-identical output, with and without cached tx encodings.
+    bool same = true;
+    for (const auto& tx : plain.transactions) {
+        same = same && legacy::txBody(tx) == serializeTxForSigning(tx);
+    }
+    for (const Block* b : {&plain, &cached}) {
+        same = same && simpleHash32(legacy::bodySection(*b)) == computeBodyRoot(b->transactions);
+        same = same && legacy::blockHash(*b) == computeBlockHash(*b);
+        same = same && legacy::witness(*b) == serializeBlockWitness(*b);
+        same = same && simpleHash32(legacy::witness(*b)) == computeWitnessRoot(*b);
+        same = same && legacy::fullBlock(*b) == serializeFullBlock(*b);
+        same = same && fullBlockSize(*b) == legacy::fullBlock(*b).size();
+    }
+    Block pruned = plain;
+    pruneBlockWitness(pruned);
+    same = same && legacy::fullBlock(pruned) == serializeFullBlock(pruned);
+    Block decoded = deserializeFullBlock(serializeFullBlock(plain));
+    same = same && serializeFullBlock(decoded) == serializeFullBlock(plain);
+    std::cout << "[Check] Byte-identical to the legacy encoders (incl. round trip): "
+              << (same ? "yes" : "NO") << "\n\n";
+
+    // 2. Throughput.
+    size_t hash_bytes = legacy::bodySection(plain).size();
+    size_t full_bytes = legacy::fullBlock(plain).size();
+    size_t witness_bytes = legacy::witness(plain).size();
+    size_t body_bytes = 0;
+    for (const auto& tx : plain.transactions) {
+        body_bytes += legacy::txBody(tx).size();
+    }
+
+    struct Row {
+        std::string what;
+        size_t bytes;
+        std::function<void()> before, after;
+    };
+    std::vector<Row> rows = {
+        {"tx bodies", body_bytes,
+         [&] { for (const auto& tx : plain.transactions) legacy::txBody(tx); },
+         [&] { for (const auto& tx : plain.transactions) serializeTxForSigning(tx); }},
+        {"body root", hash_bytes,
+         [&] { simpleHash32(legacy::bodySection(plain)); },
+         [&] { computeBodyRoot(plain.transactions); }},
+        {"block hash", hash_bytes,
+         [&] { legacy::blockHash(plain); },
+         [&] { computeBlockHash(plain); }},
+        {"witness root", witness_bytes,
+         [&] { simpleHash32(legacy::witness(plain)); },
+         [&] { computeWitnessRoot(plain); }},
+        {"full block", full_bytes,
+         [&] { legacy::fullBlock(plain); },
+         [&] { serializeFullBlock(plain); }},
+    };
+
+    std::cout << std::left << std::setw(16) << "encoding" << std::right
+              << std::setw(13) << "legacy MB/s" << std::setw(11) << "new MB/s"
+              << std::setw(9) << "speedup" << "\n";
+    for (const auto& r : rows) {
+        double before = throughput(ITERS, r.bytes, r.before);
+        double after = throughput(ITERS, r.bytes, r.after);
+        std::cout << std::left << std::setw(16) << r.what << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(13) << before << std::setw(11) << after
+                  << std::setw(8) << std::setprecision(2) << (before > 0 ? after / before : 0.0) << "x\n";
+        std::cout.unsetf(std::ios::fixed);
+    }
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "randomness.h"
+#include "soak.h"
+#include "thread_affinity.h"
+
+static double mb(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+// Usage: crypto_soak.exe [duration_s] [producers] [validators]
+//                        [block_interval_ms] [max_block_txs] [prune_depth]
+// Thread counts default to half the hardware threads each (at least 1).
+int main(int argc, char** argv) {
+    unsigned half = hardwareThreadCount() / 2 ? hardwareThreadCount() / 2 : 1;
+
+    SoakConfig cfg;
+    cfg.duration_ms = (argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 60) * 1000;
+    cfg.producers = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : half;
+    cfg.validators = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : half;
+    if (argc > 4) cfg.block_interval_ms = std::strtoull(argv[4], nullptr, 10);
+    if (argc > 5) cfg.max_block_txs = static_cast<size_t>(std::atoll(argv[5]));
+    if (argc > 6) cfg.witness_prune_depth = static_cast<size_t>(std::atoll(argv[6]));
+
+    AlgoConfig algo = getSelectedAlgorithm();
+    auto crypto = createCrypto(algo);
+
+    std::cout << "=== Soak benchmark (sustained end-to-end TPS) ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << "), RNG: " << rngDescription() << "\n";
+    std::cout << cfg.duration_ms / 1000 << " s, " << cfg.producers << " producer(s), "
+              << cfg.validators << " validator(s), block every " << cfg.block_interval_ms
+              << " ms or " << cfg.max_block_txs << " txs, witness prune depth "
+              << cfg.witness_prune_depth << ", " << hardwareThreadCount() << " hardware thread(s)\n";
+    std::cout << "Latency = start of signing -> block appended.\n\n";
+
+    std::cout << std::setw(8) << "t_s" << std::setw(11) << "tps" << std::setw(10) << "blocks"
+              << std::setw(11) << "p50_ms" << std::setw(11) << "p99_ms"
+              << std::setw(9) << "mempool" << std::setw(10) << "rss_MB" << "\n";
+    SoakReport r = runSoak(algo, cfg, [](const SoakSample& s) {
+        std::cout << std::fixed << std::setprecision(1)
+                  << std::setw(8) << s.t_s << std::setw(11) << s.tps << std::setw(10) << s.blocks
+                  << std::setprecision(2)
+                  << std::setw(11) << s.p50_us / 1000.0 << std::setw(11) << s.p99_us / 1000.0
+                  << std::setw(9) << s.mempool
+                  << std::setprecision(1) << std::setw(10) << mb(s.rss_bytes) << "\n";
+        std::cout.unsetf(std::ios::fixed);
+    });
+
+    std::cout << "\n[Summary] " << r.committed_txs << " of " << r.submitted_txs
+              << " submitted txs confirmed in " << r.blocks << " blocks; "
+              << std::fixed << std::setprecision(1) << r.tps() << " tx/s sustained\n";
+    std::cout << "[Latency] p50 " << std::setprecision(2) << r.p50_us / 1000.0
+              << " ms, p90 " << r.p90_us / 1000.0 << " ms, p99 " << r.p99_us / 1000.0
+              << " ms, p99.9 " << r.p999_us / 1000.0 << " ms, max " << r.max_us / 1000.0 << " ms\n";
+    std::cout << "[Memory] RSS " << std::setprecision(1) << mb(r.rss_warm_bytes) << " MB after warm-up ("
+              << r.warm_t_s << " s) -> " << mb(r.rss_end_bytes) << " MB at end; drift "
+              << std::setprecision(2) << mb(r.rssDriftPerMinute()) << " MB/min, "
+              << std::setprecision(0) << r.rssGrowthPerTx() << " bytes per confirmed tx\n";
+    std::cout.unsetf(std::ios::fixed);
+    if (!r.ok()) {
+        std::cout << "[Error] " << r.rejected_blocks << " block(s) rejected\n";
+        return 1;
+    }
+    return 0;
+}
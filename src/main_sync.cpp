@@ -0,0 +1,119 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "timing.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "transaction.h"
+
+// Sync 'blocks' into a fresh chain, optionally with a checkpoint, and
+// print how long it took and how much was verified.
+static SyncResult runSync(const std::string& label,
+                          std::shared_ptr<Crypto> crypto,
+                          const std::vector<Block>& blocks,
+                          const AssumeValidCheckpoint* cp) {
+    Blockchain node(crypto);
+    if (cp) {
+        node.setAssumeValid(*cp);
+    }
+
+    auto t1 = nowMicros();
+    SyncResult res = node.syncBlocks(blocks);
+    auto t2 = nowMicros();
+
+    std::cout << "[" << label << "] appended: " << res.appended << "/" << blocks.size()
+              << "  sig checks skipped: " << res.sig_checks_skipped << " blocks"
+              << "  checkpoint used: " << (res.checkpoint_used ? "yes" : "no")
+              << "  sync time: " << (t2 - t1) << " us";
+    if (res.appended) {
+        std::cout << " (" << static_cast<double>(t2 - t1) / res.appended << " us/block)";
+    }
+    std::cout << "\n";
+    return res;
+}
+
+int main() {
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    const size_t BLOCK_COUNT = 50;
+    const size_t TX_PER_BLOCK = 100;
+
+    std::cout << "=== Assume-valid sync benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << ")\n";
+    std::cout << "Chain: " << BLOCK_COUNT << " blocks x "
+              << TX_PER_BLOCK << " tx\n\n";
+
+    // 1. Produce the chain to sync (Alice -> Bob, increasing nonces).
+    Wallet alice(crypto);
+    Wallet bob(crypto);
+    alice.generateNewKeypair();
+    bob.generateNewKeypair();
+
+    Blockchain producer(crypto);
+    std::vector<Block> blocks;
+    uint64_t nonce = 1;
+    for (size_t b = 0; b < BLOCK_COUNT; ++b) {
+        std::vector<Transaction> txs;
+        txs.reserve(TX_PER_BLOCK);
+        for (size_t i = 0; i < TX_PER_BLOCK; ++i, ++nonce) {
+            txs.push_back(alice.createTransaction(bob.publicKey(), nonce, nonce));
+        }
+        Block block = producer.createBlockWithTransactions(txs);
+        if (!producer.appendBlock(block)) {
+            std::cerr << "Producer rejected its own block " << block.index << "\n";
+            return 1;
+        }
+        blocks.push_back(std::move(block));
+    }
+
+    const Block& tip = blocks.back();
+    const Block& mid = blocks[BLOCK_COUNT / 2 - 1];
+
+    // 2. Sync time with and without the checkpoint.
+    SyncResult full = runSync("Full verify", crypto, blocks, nullptr);
+
+    AssumeValidCheckpoint cp_tip{tip.index, tip.block_hash};
+    runSync("Checkpoint@tip", crypto, blocks, &cp_tip);
+
+    AssumeValidCheckpoint cp_mid{mid.index, mid.block_hash};
+    runSync("Checkpoint@mid", crypto, blocks, &cp_mid);
+
+    // 3. A checkpoint whose hash does not match must fall back to full
+    //    verification of every block.
+    AssumeValidCheckpoint cp_bad = cp_tip;
+    cp_bad.block_hash[0] ^= 0x01;
+    SyncResult bad = runSync("Bad checkpoint", crypto, blocks, &cp_bad);
+
+    bool fallback_ok = !bad.checkpoint_used && bad.appended == full.appended;
+    std::cout << "\n[Fallback] Mismatched checkpoint fully verified: "
+              << (fallback_ok ? "OK" : "FAIL") << "\n";
+
+    // 4. Forge a signature in block 3, then recommit the witness, re-hash
+    //    and relink the rest so linkage is consistent. The tip no longer
+    //    matches the trusted hash, so sync must fall back and reject
+    //    block 3 on its signature.
+    std::vector<Block> forged = blocks;
+    forged[2].transactions[0].signature[0] ^= 0x01;
+    forged[2].witness_root = computeWitnessRoot(forged[2]);
+    for (size_t i = 2; i < forged.size(); ++i) {
+        if (i > 2) {
+            forged[i].prev_hash = forged[i - 1].block_hash;
+        }
+        forged[i].block_hash = computeBlockHash(forged[i]);
+    }
+    SyncResult caught = runSync("Forged chain", crypto, forged, &cp_tip);
+    bool caught_ok = !caught.checkpoint_used && caught.appended == 2;
+    std::cout << "[Fallback] Forged signature rejected at block 3: "
+              << (caught_ok ? "OK" : "FAIL") << "\n";
+
+    return (fallback_ok && caught_ok) ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "timing.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "transaction.h"
+
+// How transactions are signed and whether their encoding is kept.
+struct TxPath {
+    const char* label;
+    TxSigMode mode;
+    bool cached; // false = drop the cache, re-serialize at every step
+};
+
+// Per-tx microseconds for each stage of a transaction's life in a block.
+struct TxCost {
+    double sign_us = 0;
+    double build_us = 0;     // witness root + block hash
+    double serialize_us = 0;
+    double validate_us = 0;
+    bool ok = true;
+
+    double total() const { return sign_us + build_us + serialize_us + validate_us; }
+};
+
+static TxCost runPath(const std::shared_ptr<Crypto>& crypto, const TxPath& path,
+                      size_t tx_count, size_t validate_iters) {
+    Blockchain chain(crypto);
+    Wallet alice(crypto);
+    Wallet bob(crypto);
+    alice.generateNewKeypair();
+    bob.generateNewKeypair();
+    alice.setSigMode(path.mode);
+
+    TxCost cost;
+    std::vector<Transaction> txs;
+    txs.reserve(tx_count);
+
+    auto t1 = nowMicros();
+    for (uint64_t i = 1; i <= tx_count; ++i) {
+        txs.push_back(alice.createTransaction(bob.publicKey(), i, i));
+        if (!path.cached) {
+            clearTxEncoding(txs.back());
+        }
+    }
+    auto t2 = nowMicros();
+    Block block = chain.createBlockWithTransactions(txs);
+    auto t3 = nowMicros();
+    serializeFullBlock(block);
+    auto t4 = nowMicros();
+    for (size_t i = 0; i < validate_iters; ++i) {
+        cost.ok = cost.ok && chain.validateBlock(block);
+    }
+    auto t5 = nowMicros();
+
+    cost.sign_us = static_cast<double>(t2 - t1) / tx_count;
+    cost.build_us = static_cast<double>(t3 - t2) / tx_count;
+    cost.serialize_us = static_cast<double>(t4 - t3) / tx_count;
+    cost.validate_us = static_cast<double>(t5 - t4) / (tx_count * validate_iters);
+    return cost;
+}
+
+int main() {
+    const size_t TX_COUNT = 500;
+    const size_t VALIDATE_ITERS = 5;
+
+    std::vector<TxPath> paths = {
+        {"body/uncached", TxSigMode::BODY, false},
+        {"body/cached", TxSigMode::BODY, true},
+        {"digest/cached", TxSigMode::DIGEST, true},
+    };
+
+    std::cout << "=== Tx id / digest signing benchmark ===\n";
+    std::cout << TX_COUNT << " tx per block, validation averaged over "
+              << VALIDATE_ITERS << " runs. Times are us per tx.\n";
+    std::cout << "body/uncached re-serializes the body at every step (previous behaviour).\n\n";
+
+    std::cout << std::left << std::setw(13) << "algorithm" << std::setw(15) << "path" << std::right
+              << std::setw(10) << "sign" << std::setw(10) << "build"
+              << std::setw(11) << "serialize" << std::setw(10) << "validate"
+              << std::setw(10) << "total" << std::setw(9) << "vs base" << "\n";
+
+    bool all_ok = true;
+    for (const auto& cfg : allAlgorithms()) {
+        auto crypto = createCrypto(cfg);
+
+        double base = 0.0;
+        for (const auto& path : paths) {
+            TxCost c = runPath(crypto, path, TX_COUNT, VALIDATE_ITERS);
+            if (base == 0.0) {
+                base = c.total();
+            }
+            all_ok = all_ok && c.ok;
+
+            std::cout << std::left << std::setw(13) << crypto->name()
+                      << std::setw(15) << path.label << std::right << std::fixed
+                      << std::setprecision(2)
+                      << std::setw(10) << c.sign_us
+                      << std::setw(10) << c.build_us
+                      << std::setw(11) << c.serialize_us
+                      << std::setw(10) << c.validate_us
+                      << std::setw(10) << c.total()
+                      << std::setw(8) << (c.total() > 0 ? base / c.total() : 0.0) << "x"
+                      << (c.ok ? "" : "  VALIDATION FAILED") << "\n";
+            std::cout.unsetf(std::ios::fixed);
+        }
+    }
+
+    // The tx id must not depend on whether it was cached.
+    {
+        auto crypto = createCrypto(getSelectedAlgorithm());
+        Wallet w(crypto);
+        w.generateNewKeypair();
+        w.setSigMode(TxSigMode::DIGEST);
+        Transaction tx = w.createTransaction(w.publicKey(), 1, 1);
+        TxId cached = computeTxId(tx);
+        clearTxEncoding(tx);
+        bool same = computeTxId(tx) == cached;
+        std::cout << "\n[TxId] cached == recomputed: " << (same ? "yes" : "NO") << "\n";
+        all_ok = all_ok && same;
+    }
+
+    // A copy whose fields were changed after signing shares the original's
+    // cached encoding. It must be hashed, stored and verified by its own
+    // fields, so the block is rejected.
+    for (TxSigMode mode : {TxSigMode::BODY, TxSigMode::DIGEST}) {
+        auto crypto = createCrypto(getSelectedAlgorithm());
+        Wallet w(crypto);
+        w.generateNewKeypair();
+        w.setSigMode(mode);
+        Transaction tx = w.createTransaction(w.publicKey(), 5, 1);
+        Transaction forged = tx;
+        forged.amount = 1000000;
+
+        Blockchain honest(crypto);
+        bool accepted = honest.appendBlock(honest.createBlockWithTransactions({tx}));
+        Blockchain chain(crypto);
+        Block block = chain.createBlockWithTransactions({forged});
+        bool rejected = !chain.appendBlock(block);
+        bool stored = deserializeFullBlock(serializeFullBlock(block)).transactions[0].amount == 1000000;
+        bool new_id = computeTxId(forged) != computeTxId(tx);
+
+        bool ok = accepted && rejected && stored && new_id;
+        std::cout << "[Tamper] " << (mode == TxSigMode::BODY ? "body" : "digest")
+                  << " tx, amount changed on a copy after signing: "
+                  << (ok ? "block rejected" : "NOT DETECTED") << "\n";
+        all_ok = all_ok && ok;
+    }
+
+    return all_ok ? 0 : 1;
+}
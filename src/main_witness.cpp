@@ -0,0 +1,173 @@
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "wallet.h"
+#include "blockchain.h"
+#include "block.h"
+#include "transaction.h"
+#include "mem_accounting.h"
+
+#if defined(_WIN32)
+#define popen _popen
+#define pclose _pclose
+#endif
+
+static const size_t BLOCK_COUNT = 20;
+static const size_t TX_PER_BLOCK = 100;
+static const size_t PRUNE_DEPTH = 4;
+
+struct ChainFootprint {
+    size_t storage_bytes = 0;  // sum of serializeFullBlock sizes
+    size_t memory_bytes = 0;   // sum of blockMemoryFootprint (estimate)
+    long long rss_bytes = 0;   // measured RSS growth while building (fresh process)
+};
+
+static ChainFootprint measure(const std::vector<Block>& blocks) {
+    ChainFootprint f;
+    for (const auto& b : blocks) {
+        f.storage_bytes += serializeFullBlock(b).size();
+        f.memory_bytes += blockMemoryFootprint(b);
+    }
+    return f;
+}
+
+// Every block hash must still check out after pruning.
+static bool hashesStillVerify(const std::vector<Block>& blocks) {
+    for (size_t i = 1; i < blocks.size(); ++i) {
+        if (!checkLinkageAndHash(blocks[i - 1], blocks[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Signs and appends BLOCK_COUNT blocks to every chain in 'chains' (the
+// same blocks to each). False if one is rejected.
+static bool buildChains(const std::shared_ptr<Crypto>& crypto, const std::vector<Blockchain*>& chains) {
+    Wallet alice(crypto);
+    Wallet bob(crypto);
+    alice.generateNewKeypair();
+    bob.generateNewKeypair();
+
+    uint64_t nonce = 1;
+    for (size_t b = 0; b < BLOCK_COUNT; ++b) {
+        std::vector<Transaction> txs;
+        txs.reserve(TX_PER_BLOCK);
+        for (size_t i = 0; i < TX_PER_BLOCK; ++i, ++nonce) {
+            txs.push_back(alice.createTransaction(bob.publicKey(), nonce, nonce));
+        }
+        Block block = chains.front()->createBlockWithTransactions(txs);
+        for (Blockchain* c : chains) {
+            if (!c->appendBlock(block)) {
+                std::cerr << crypto->name() << ": block " << block.index << " rejected\n";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Child mode: build one chain in this fresh process and print its RSS
+// growth. A fresh process keeps memory freed by other chains (pruned
+// witnesses, other algorithms) from being reused and hiding the growth.
+static int rssChild(size_t algo, size_t prune_depth) {
+    auto crypto = createCrypto(allAlgorithms().at(algo));
+    Blockchain chain(crypto);
+    chain.setWitnessPruneDepth(prune_depth);
+    size_t rss0 = currentRssBytes();
+    if (!buildChains(crypto, {&chain})) {
+        return 1;
+    }
+    std::cout << static_cast<long long>(currentRssBytes()) - static_cast<long long>(rss0) << "\n";
+    return 0;
+}
+
+// Runs 'self --rss-child algo depth'; false if it fails.
+static bool measureRss(const std::string& self, size_t algo, size_t prune_depth, long long& rss) {
+    std::string cmd = "\"" + self + "\" --rss-child " + std::to_string(algo) + " " +
+                      std::to_string(prune_depth);
+    FILE* p = popen(cmd.c_str(), "r");
+    if (!p) {
+        return false;
+    }
+    bool ok = std::fscanf(p, "%lld", &rss) == 1;
+    return pclose(p) == 0 && ok;
+}
+
+// Usage: crypto_witness.exe  (--rss-child is used internally)
+int main(int argc, char** argv) {
+    if (argc == 4 && std::string(argv[1]) == "--rss-child") {
+        return rssChild(std::strtoul(argv[2], nullptr, 10), std::strtoul(argv[3], nullptr, 10));
+    }
+
+    std::cout << "=== Witness pruning benchmark ===\n";
+    std::cout << "Chain: " << BLOCK_COUNT << " blocks x " << TX_PER_BLOCK
+              << " tx, witness kept for the newest " << PRUNE_DEPTH << " blocks\n";
+    std::cout << "memory_* is estimated from container capacities; rss_* is the\n"
+                 "measured RSS growth while building each chain in a fresh child\n"
+                 "process, in KB. Other sizes in bytes.\n\n";
+
+    std::cout << std::left << std::setw(13) << "algorithm" << std::right
+              << std::setw(14) << "storage_full"
+              << std::setw(15) << "storage_pruned"
+              << std::setw(9) << "saved%"
+              << std::setw(13) << "memory_full"
+              << std::setw(15) << "memory_pruned"
+              << std::setw(9) << "saved%"
+              << std::setw(10) << "rss_full"
+              << std::setw(12) << "rss_pruned"
+              << std::setw(9) << "saved%"
+              << std::setw(10) << "hashes" << "\n";
+
+    bool all_ok = true;
+    const auto algos = allAlgorithms();
+    for (size_t a = 0; a < algos.size(); ++a) {
+        auto crypto = createCrypto(algos[a]);
+
+        Blockchain full(crypto);
+        Blockchain pruned(crypto);
+        pruned.setWitnessPruneDepth(PRUNE_DEPTH);
+        if (!buildChains(crypto, {&full, &pruned})) {
+            return 1;
+        }
+
+        ChainFootprint f_full = measure(full.blocks());
+        ChainFootprint f_pruned = measure(pruned.blocks());
+        if (!measureRss(argv[0], a, 0, f_full.rss_bytes) ||
+            !measureRss(argv[0], a, PRUNE_DEPTH, f_pruned.rss_bytes)) {
+            std::cerr << crypto->name() << ": RSS child process failed\n";
+            return 1;
+        }
+        bool hashes_ok = hashesStillVerify(pruned.blocks());
+        all_ok = all_ok && hashes_ok;
+
+        auto pct = [](double before, double after) {
+            return before > 0 ? 100.0 * (before - after) / before : 0.0;
+        };
+
+        std::cout << std::left << std::setw(13) << crypto->name() << std::right
+                  << std::setw(14) << f_full.storage_bytes
+                  << std::setw(15) << f_pruned.storage_bytes
+                  << std::setw(9) << std::fixed << std::setprecision(1)
+                  << pct(f_full.storage_bytes, f_pruned.storage_bytes)
+                  << std::setw(13) << f_full.memory_bytes
+                  << std::setw(15) << f_pruned.memory_bytes
+                  << std::setw(9) << pct(f_full.memory_bytes, f_pruned.memory_bytes)
+                  << std::setw(10) << f_full.rss_bytes / 1024
+                  << std::setw(12) << f_pruned.rss_bytes / 1024
+                  << std::setw(9) << pct(f_full.rss_bytes, f_pruned.rss_bytes)
+                  << std::setw(10) << (hashes_ok ? "OK" : "FAIL") << "\n";
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>
+
+#include "algo_config.h"
+#include "crypto_factory.h"
+#include "crypto.h"
+#include "timing.h"
+#include "workload.h"
+#include "blockchain.h"
+#include "block.h"
+#include "transaction.h"
+
+// Usage: crypto_workload.exe [path] [uniform|zipf]
+// If 'path' exists the workload is loaded from it (no signing);
+// otherwise it is generated with the config below and saved there.
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "workload.bin";
+    std::string dist = argc > 2 ? argv[2] : "zipf";
+
+    AlgoConfig cfg = getSelectedAlgorithm();
+    auto crypto = createCrypto(cfg);
+
+    WorkloadConfig wcfg;
+    wcfg.seed = 42;
+    wcfg.account_count = 1000;
+    wcfg.block_count = 20;
+    wcfg.tx_per_block = 500;
+    wcfg.sender_dist = (dist == "uniform") ? AccountDistribution::UNIFORM
+                                           : AccountDistribution::ZIPF;
+    wcfg.receiver_dist = wcfg.sender_dist;
+    wcfg.zipf_s = 1.1;
+
+    std::cout << "=== Workload replay benchmark ===\n";
+    std::cout << "Algorithm: " << crypto->name()
+              << " (family=" << crypto->family()
+              << ", variant=" << crypto->variant() << ")\n";
+
+    // 1. Load or generate + save.
+    Workload w;
+    bool exists = static_cast<bool>(std::ifstream(path, std::ios::binary));
+    if (exists) {
+        auto t1 = nowMicros();
+        w = loadWorkload(path);
+        auto t2 = nowMicros();
+        std::cout << "[Workload] Loaded " << path << " in " << (t2 - t1) << " us\n";
+        if (w.scheme != crypto->schemeId()) {
+            std::cerr << "Workload was generated for a different scheme. "
+                         "Delete " << path << " or switch algorithms.\n";
+            return 1;
+        }
+    } else {
+        std::cout << "[Workload] Generating " << wcfg.account_count << " accounts, "
+                  << wcfg.block_count << " blocks x " << wcfg.tx_per_block << " tx...\n";
+        auto t1 = nowMicros();
+        w = generateWorkload(wcfg, crypto);
+        auto t2 = nowMicros();
+        saveWorkload(path, w);
+        auto t3 = nowMicros();
+        std::cout << "[Workload] Generated in " << (t2 - t1) << " us, saved to "
+                  << path << " in " << (t3 - t2) << " us\n";
+    }
+
+    const WorkloadConfig& c = w.config;
+    std::cout << "[Workload] seed=" << c.seed
+              << " accounts=" << c.account_count
+              << " blocks=" << c.block_count
+              << " tx/block=" << c.tx_per_block
+              << " senders=" << distributionName(c.sender_dist)
+              << " receivers=" << distributionName(c.receiver_dist);
+    if (c.sender_dist == AccountDistribution::ZIPF || c.receiver_dist == AccountDistribution::ZIPF) {
+        std::cout << " (s=" << c.zipf_s << ")";
+    }
+    std::cout << "\n";
+
+    // 2. Traffic skew: how concentrated are the senders?
+    std::map<std::vector<uint8_t>, size_t> per_sender;
+    size_t total_tx = 0;
+    for (const auto& txs : w.blocks) {
+        for (const auto& tx : txs) {
+            ++per_sender[tx.from_pubkey];
+            ++total_tx;
+        }
+    }
+    size_t top = 0;
+    for (const auto& kv : per_sender) {
+        top = std::max(top, kv.second);
+    }
+    std::cout << "[Workload] Distinct senders: " << per_sender.size()
+              << ", busiest sender share: "
+              << (total_tx ? 100.0 * top / total_tx : 0.0) << " %\n\n";
+
+    // 3. Replay: build each block on a fresh chain, validate, append.
+    Blockchain chain(crypto);
+    uint64_t build_total_us = 0;
+    uint64_t validate_total_us = 0;
+    for (const auto& txs : w.blocks) {
+        auto t1 = nowMicros();
+        Block block = chain.createBlockWithTransactions(txs);
+        auto t2 = nowMicros();
+        bool ok = chain.appendBlock(block);
+        auto t3 = nowMicros();
+        if (!ok) {
+            std::cerr << "Replay: block " << block.index << " failed validation\n";
+            return 1;
+        }
+        build_total_us += (t2 - t1);
+        validate_total_us += (t3 - t2);
+    }
+
+    size_t blocks = w.blocks.size();
+    std::cout << "[Replay] Blocks: " << blocks << ", transactions: " << total_tx << "\n";
+    if (blocks && total_tx) {
+        std::cout << "[Replay] Avg block build time:    "
+                  << static_cast<double>(build_total_us) / blocks << " us\n";
+        std::cout << "[Replay] Avg block validate time: "
+                  << static_cast<double>(validate_total_us) / blocks << " us\n";
+        std::cout << "[Replay] Avg validate per tx:     "
+                  << static_cast<double>(validate_total_us) / total_tx << " us\n";
+        std::cout << "[Replay] Validation throughput:   "
+                  << total_tx * 1e6 / std::max<uint64_t>(1, validate_total_us) << " tx/s\n";
+    }
+
+    return 0;
+}
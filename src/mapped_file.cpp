@@ -0,0 +1,188 @@
+#include "mapped_file.h"
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static void fail(const std::string& what, const std::string& path) {
+    throw std::runtime_error("MappedFile: " + what + " '" + path + "'");
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(writable_, other.writable_);
+#if defined(_WIN32)
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#else
+        std::swap(fd_, other.fd_);
+#endif
+    }
+    return *this;
+}
+
+#if defined(_WIN32)
+
+MappedFile MappedFile::openReadOnly(const std::string& path) {
+    MappedFile m;
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) {
+        fail("cannot open", path);
+    }
+    m.file_ = f;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(f, &size)) {
+        fail("cannot stat", path);
+    }
+    m.size_ = static_cast<size_t>(size.QuadPart);
+    if (m.size_ == 0) {
+        return m;
+    }
+    m.mapping_ = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m.mapping_) {
+        fail("cannot map", path);
+    }
+    m.data_ = static_cast<uint8_t*>(MapViewOfFile(m.mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!m.data_) {
+        fail("cannot map", path);
+    }
+    return m;
+}
+
+MappedFile MappedFile::create(const std::string& path, size_t size) {
+    MappedFile m;
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                           CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (f == INVALID_HANDLE_VALUE) {
+        fail("cannot create", path);
+    }
+    m.file_ = f;
+    m.size_ = size;
+    m.writable_ = true;
+    if (size == 0) {
+        return m;
+    }
+    // Mapping with an explicit size extends the file to it.
+    uint64_t s = size;
+    m.mapping_ = CreateFileMappingA(f, nullptr, PAGE_READWRITE,
+                                    static_cast<DWORD>(s >> 32), static_cast<DWORD>(s), nullptr);
+    if (!m.mapping_) {
+        fail("cannot map", path);
+    }
+    m.data_ = static_cast<uint8_t*>(MapViewOfFile(m.mapping_, FILE_MAP_WRITE, 0, 0, 0));
+    if (!m.data_) {
+        fail("cannot map", path);
+    }
+    return m;
+}
+
+void MappedFile::flush() {
+    if (writable_ && data_) {
+        if (!FlushViewOfFile(data_, 0) || !FlushFileBuffers(static_cast<HANDLE>(file_))) {
+            throw std::runtime_error("MappedFile: flush failed");
+        }
+    }
+}
+
+void MappedFile::release() noexcept {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+    }
+    if (file_) {
+        CloseHandle(static_cast<HANDLE>(file_));
+    }
+    data_ = nullptr;
+    mapping_ = nullptr;
+    file_ = nullptr;
+    size_ = 0;
+    writable_ = false;
+}
+
+#else
+
+MappedFile MappedFile::openReadOnly(const std::string& path) {
+    MappedFile m;
+    m.fd_ = ::open(path.c_str(), O_RDONLY);
+    if (m.fd_ < 0) {
+        fail("cannot open", path);
+    }
+    struct stat st;
+    if (::fstat(m.fd_, &st) != 0) {
+        fail("cannot stat", path);
+    }
+    m.size_ = static_cast<size_t>(st.st_size);
+    if (m.size_ == 0) {
+        return m;
+    }
+    void* p = ::mmap(nullptr, m.size_, PROT_READ, MAP_SHARED, m.fd_, 0);
+    if (p == MAP_FAILED) {
+        fail("cannot map", path);
+    }
+    m.data_ = static_cast<uint8_t*>(p);
+    return m;
+}
+
+MappedFile MappedFile::create(const std::string& path, size_t size) {
+    MappedFile m;
+    m.fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (m.fd_ < 0) {
+        fail("cannot create", path);
+    }
+    if (::ftruncate(m.fd_, static_cast<off_t>(size)) != 0) {
+        fail("cannot resize", path);
+    }
+    m.size_ = size;
+    m.writable_ = true;
+    if (size == 0) {
+        return m;
+    }
+    void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m.fd_, 0);
+    if (p == MAP_FAILED) {
+        fail("cannot map", path);
+    }
+    m.data_ = static_cast<uint8_t*>(p);
+    return m;
+}
+
+void MappedFile::flush() {
+    if (writable_ && data_ && ::msync(data_, size_, MS_SYNC) != 0) {
+        throw std::runtime_error("MappedFile: flush failed");
+    }
+}
+
+void MappedFile::release() noexcept {
+    if (data_) {
+        ::munmap(data_, size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    data_ = nullptr;
+    fd_ = -1;
+    size_ = 0;
+    writable_ = false;
+}
+
+#endif
@@ -0,0 +1,268 @@
+#include "mem_accounting.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <ostream>
+#include <string>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif
+
+namespace {
+
+struct PhaseCounters {
+    std::atomic<uint64_t> allocs{0};
+    std::atomic<uint64_t> frees{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::atomic<uint64_t> bytes_freed{0};
+    std::atomic<uint64_t> peak_rss_bytes{0};
+    std::atomic<int64_t> rss_growth_bytes{0};
+};
+
+constexpr size_t PHASE_COUNT = static_cast<size_t>(MemPhase::COUNT);
+
+PhaseCounters g_phases[PHASE_COUNT];
+std::atomic<bool> g_enabled{false};
+thread_local MemPhase t_phase = MemPhase::NONE;
+
+#if defined(PQBC_MEM_ACCOUNTING)
+// Every block carries this header so frees can be charged to the phase
+// (and size) of the matching allocation, whether or not accounting was on.
+struct AllocHeader {
+    uint64_t size;
+    uint8_t phase;   // MemPhase, or 0xFF if allocated while disabled
+};
+constexpr size_t HEADER_SIZE = 16;
+static_assert(sizeof(AllocHeader) <= HEADER_SIZE, "header too large");
+static_assert(alignof(std::max_align_t) <= HEADER_SIZE, "header breaks alignment");
+constexpr uint8_t UNTRACKED = 0xFF;
+
+void* allocTracked(size_t size) {
+    void* raw = std::malloc(size + HEADER_SIZE);
+    if (!raw) {
+        return nullptr;
+    }
+    auto* h = static_cast<AllocHeader*>(raw);
+    h->size = size;
+    h->phase = UNTRACKED;
+    if (g_enabled.load(std::memory_order_relaxed)) {
+        h->phase = static_cast<uint8_t>(t_phase);
+        PhaseCounters& c = g_phases[h->phase];
+        c.allocs.fetch_add(1, std::memory_order_relaxed);
+        c.bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+    }
+    return static_cast<uint8_t*>(raw) + HEADER_SIZE;
+}
+
+void freeTracked(void* p) {
+    if (!p) {
+        return;
+    }
+    void* raw = static_cast<uint8_t*>(p) - HEADER_SIZE;
+    auto* h = static_cast<AllocHeader*>(raw);
+    if (h->phase != UNTRACKED) {
+        PhaseCounters& c = g_phases[h->phase];
+        c.frees.fetch_add(1, std::memory_order_relaxed);
+        c.bytes_freed.fetch_add(h->size, std::memory_order_relaxed);
+    }
+    std::free(raw);
+}
+
+void* allocOrThrow(size_t size) {
+    void* p = allocTracked(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+#endif // PQBC_MEM_ACCOUNTING
+
+template <typename T>
+void storeMax(std::atomic<T>& slot, T v) {
+    T cur = slot.load(std::memory_order_relaxed);
+    while (v > cur && !slot.compare_exchange_weak(cur, v)) {
+    }
+}
+
+// Reads a "Key:   1234 kB" line from /proc/self/status.
+size_t readProcStatusKb(const char* key) {
+#if defined(__linux__)
+    std::ifstream f("/proc/self/status");
+    std::string line;
+    size_t key_len = std::char_traits<char>::length(key);
+    while (std::getline(f, line)) {
+        if (line.compare(0, key_len, key) == 0 && line.size() > key_len && line[key_len] == ':') {
+            return std::strtoull(line.c_str() + key_len + 1, nullptr, 10);
+        }
+    }
+#else
+    (void)key;
+#endif
+    return 0;
+}
+
+} // namespace
+
+// ---------------- Global operator new/delete ----------------
+
+// Only in builds with PQBC_MEM_ACCOUNTING: the 16-byte header on every
+// allocation changes the allocation pattern behind every timing, so normal
+// builds keep the default allocator.
+#if defined(PQBC_MEM_ACCOUNTING)
+void* operator new(size_t size) { return allocOrThrow(size); }
+void* operator new[](size_t size) { return allocOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocTracked(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocTracked(size); }
+
+void operator delete(void* p) noexcept { freeTracked(p); }
+void operator delete[](void* p) noexcept { freeTracked(p); }
+void operator delete(void* p, size_t) noexcept { freeTracked(p); }
+void operator delete[](void* p, size_t) noexcept { freeTracked(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { freeTracked(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { freeTracked(p); }
+#endif
+
+
+// ---------------- Public API ----------------
+
+bool memAccountingBuiltIn() {
+#if defined(PQBC_MEM_ACCOUNTING)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void setMemAccountingEnabled(bool on) {
+    g_enabled.store(on && memAccountingBuiltIn(), std::memory_order_relaxed);
+}
+
+bool memAccountingEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+const char* memPhaseName(MemPhase p) {
+    switch (p) {
+    case MemPhase::NONE:        return "untagged";
+    case MemPhase::KEYGEN:      return "keygen";
+    case MemPhase::SIGN:        return "sign";
+    case MemPhase::BUILD_BLOCK: return "build block";
+    case MemPhase::HASH:        return "hash";
+    case MemPhase::SERIALIZE:   return "serialize";
+    case MemPhase::VALIDATE:    return "validate";
+    default:                    return "?";
+    }
+}
+
+MemPhaseStats memPhaseStats(MemPhase p) {
+    const PhaseCounters& c = g_phases[static_cast<size_t>(p)];
+    MemPhaseStats s;
+    s.allocs = c.allocs.load(std::memory_order_relaxed);
+    s.frees = c.frees.load(std::memory_order_relaxed);
+    s.bytes_allocated = c.bytes_allocated.load(std::memory_order_relaxed);
+    s.bytes_freed = c.bytes_freed.load(std::memory_order_relaxed);
+    s.peak_rss_bytes = c.peak_rss_bytes.load(std::memory_order_relaxed);
+    s.rss_growth_bytes = c.rss_growth_bytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+void resetMemPhaseStats() {
+    for (auto& c : g_phases) {
+        c.allocs = 0;
+        c.frees = 0;
+        c.bytes_allocated = 0;
+        c.bytes_freed = 0;
+        c.peak_rss_bytes = 0;
+        c.rss_growth_bytes = 0;
+    }
+}
+
+MemPhaseScope::MemPhaseScope(MemPhase phase, bool sample_rss)
+    : phase_(phase), prev_(t_phase), sample_rss_(sample_rss && memAccountingEnabled()) {
+    t_phase = phase;
+    if (sample_rss_) {
+        rss_at_entry_ = currentRssBytes();
+    }
+}
+
+MemPhaseScope::~MemPhaseScope() {
+    t_phase = prev_;
+    if (sample_rss_) {
+        PhaseCounters& c = g_phases[static_cast<size_t>(phase_)];
+        int64_t growth = static_cast<int64_t>(currentRssBytes()) - static_cast<int64_t>(rss_at_entry_);
+        storeMax(c.rss_growth_bytes, growth);
+        storeMax(c.peak_rss_bytes, static_cast<uint64_t>(peakRssBytes()));
+    }
+}
+
+size_t currentRssBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return pmc.WorkingSetSize;
+    }
+    return 0;
+#else
+    return readProcStatusKb("VmRSS") * 1024;
+#endif
+}
+
+size_t peakRssBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+        return pmc.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    return readProcStatusKb("VmHWM") * 1024;
+#endif
+}
+
+void printMemoryTable(std::ostream& os) {
+    auto flags = os.flags();
+    auto prec = os.precision();
+
+    os << std::left << std::setw(13) << "phase" << std::right
+       << std::setw(12) << "allocs"
+       << std::setw(12) << "frees"
+       << std::setw(14) << "alloc_MB"
+       << std::setw(14) << "live_KB"
+       << std::setw(14) << "rss_grow_MB"
+       << std::setw(16) << "proc_peak_MB" << "\n";
+
+    os << std::fixed;
+    for (size_t i = 0; i < PHASE_COUNT; ++i) {
+        MemPhaseStats s = memPhaseStats(static_cast<MemPhase>(i));
+        if (s.allocs == 0 && s.frees == 0 && s.peak_rss_bytes == 0) {
+            continue;
+        }
+        os << std::left << std::setw(13) << memPhaseName(static_cast<MemPhase>(i)) << std::right
+           << std::setw(12) << s.allocs
+           << std::setw(12) << s.frees
+           << std::setw(14) << std::setprecision(2) << s.bytes_allocated / (1024.0 * 1024.0)
+           << std::setw(14) << std::setprecision(1) << s.liveBytes() / 1024.0;
+        if (s.peak_rss_bytes) {
+            os << std::setw(14) << std::setprecision(1) << s.rss_growth_bytes / (1024.0 * 1024.0)
+               << std::setw(16) << s.peak_rss_bytes / (1024.0 * 1024.0);
+        } else {
+            os << std::setw(14) << "-" << std::setw(16) << "-";
+        }
+        os << "\n";
+    }
+    os << "rss_grow = largest current-RSS change across one scope of the phase;\n"
+          "proc_peak = process peak RSS so far when the phase last ended (monotonic).\n";
+
+    os << std::setprecision(1)
+       << "Process RSS: " << currentRssBytes() / (1024.0 * 1024.0) << " MB current, "
+       << peakRssBytes() / (1024.0 * 1024.0) << " MB peak\n";
+
+    os.flags(flags);
+    os.precision(prec);
+}
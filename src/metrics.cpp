@@ -0,0 +1,269 @@
+#include "metrics.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+static std::atomic<bool> g_metrics_enabled{true};
+
+void setMetricsEnabled(bool on) {
+    g_metrics_enabled.store(on, std::memory_order_relaxed);
+}
+
+bool metricsEnabled() {
+    return g_metrics_enabled.load(std::memory_order_relaxed);
+}
+
+uint64_t metricsNowNanos() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(
+        steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void Histogram::observeNanos(uint64_t ns) {
+    size_t i = 0;
+    while (i < BUCKET_COUNT && ns > bucketUpperNanos(i)) {
+        ++i;
+    }
+    buckets_[i].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+MetricsRegistry& MetricsRegistry::global() {
+    static MetricsRegistry reg;
+    return reg;
+}
+
+MetricsRegistry::Series&
+MetricsRegistry::findOrAdd(const std::string& name, const std::string& help,
+                           const MetricLabels& labels, Kind kind) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        it = families_.emplace(name, Family{kind, help, {}}).first;
+    } else if (it->second.kind != kind) {
+        throw std::runtime_error("Metric registered with two different types: " + name);
+    }
+
+    for (auto& s : it->second.series) {
+        if (s->labels == labels) {
+            return *s;
+        }
+    }
+
+    auto s = std::make_unique<Series>();
+    s->labels = labels;
+    switch (kind) {
+    case Kind::COUNTER:   s->counter = std::make_unique<Counter>(); break;
+    case Kind::GAUGE:     s->gauge = std::make_unique<Gauge>(); break;
+    case Kind::HISTOGRAM: s->histogram = std::make_unique<Histogram>(); break;
+    }
+    it->second.series.push_back(std::move(s));
+    return *it->second.series.back();
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help,
+                                  const MetricLabels& labels) {
+    return *findOrAdd(name, help, labels, Kind::COUNTER).counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help,
+                              const MetricLabels& labels) {
+    return *findOrAdd(name, help, labels, Kind::GAUGE).gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help,
+                                      const MetricLabels& labels) {
+    return *findOrAdd(name, help, labels, Kind::HISTOGRAM).histogram;
+}
+
+// ---------------- Export ----------------
+
+static std::string escapeLabelValue(const std::string& v) {
+    std::string out;
+    for (char c : v) {
+        if (c == '\\' || c == '"') out += '\\';
+        if (c == '\n') { out += "\\n"; continue; }
+        out += c;
+    }
+    return out;
+}
+
+// {a="x",b="y"} with an optional extra label appended (used for "le").
+static std::string promLabels(const MetricLabels& labels,
+                              const std::string& extra_key = "",
+                              const std::string& extra_val = "") {
+    if (labels.empty() && extra_key.empty()) {
+        return "";
+    }
+    std::string out = "{";
+    bool first = true;
+    for (const auto& kv : labels) {
+        if (!first) out += ",";
+        out += kv.first + "=\"" + escapeLabelValue(kv.second) + "\"";
+        first = false;
+    }
+    if (!extra_key.empty()) {
+        if (!first) out += ",";
+        out += extra_key + "=\"" + extra_val + "\"";
+    }
+    return out + "}";
+}
+
+static std::string nanosToSeconds(uint64_t ns) {
+    std::ostringstream oss;
+    oss.precision(9);
+    oss << static_cast<double>(ns) / 1e9;
+    return oss.str();
+}
+
+std::string MetricsRegistry::snapshot(MetricsFormat fmt) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    std::ostringstream out;
+
+    if (fmt == MetricsFormat::PROMETHEUS) {
+        for (const auto& fam : families_) {
+            const std::string& name = fam.first;
+            const Family& f = fam.second;
+            const char* type = f.kind == Kind::COUNTER ? "counter"
+                             : f.kind == Kind::GAUGE ? "gauge" : "histogram";
+            out << "# HELP " << name << " " << f.help << "\n";
+            out << "# TYPE " << name << " " << type << "\n";
+
+            for (const auto& s : f.series) {
+                if (s->counter) {
+                    out << name << promLabels(s->labels) << " " << s->counter->value() << "\n";
+                } else if (s->gauge) {
+                    out << name << promLabels(s->labels) << " " << s->gauge->value() << "\n";
+                } else {
+                    const Histogram& h = *s->histogram;
+                    uint64_t cumulative = 0;
+                    for (size_t i = 0; i < Histogram::BUCKET_COUNT; ++i) {
+                        cumulative += h.bucket(i);
+                        out << name << "_bucket"
+                            << promLabels(s->labels, "le", nanosToSeconds(Histogram::bucketUpperNanos(i)))
+                            << " " << cumulative << "\n";
+                    }
+                    cumulative += h.bucket(Histogram::BUCKET_COUNT);
+                    out << name << "_bucket" << promLabels(s->labels, "le", "+Inf")
+                        << " " << cumulative << "\n";
+                    out << name << "_sum" << promLabels(s->labels) << " "
+                        << nanosToSeconds(h.sumNanos()) << "\n";
+                    out << name << "_count" << promLabels(s->labels) << " " << h.count() << "\n";
+                }
+            }
+        }
+        return out.str();
+    }
+
+    // JSON
+    out << "{\"timestamp_ns\":" << metricsNowNanos() << ",\"metrics\":[";
+    bool first_series = true;
+    for (const auto& fam : families_) {
+        for (const auto& s : fam.second.series) {
+            if (!first_series) out << ",";
+            first_series = false;
+
+            out << "{\"name\":\"" << fam.first << "\",\"labels\":{";
+            for (size_t i = 0; i < s->labels.size(); ++i) {
+                if (i) out << ",";
+                out << "\"" << s->labels[i].first << "\":\""
+                    << escapeLabelValue(s->labels[i].second) << "\"";
+            }
+            out << "},";
+
+            if (s->counter) {
+                out << "\"type\":\"counter\",\"value\":" << s->counter->value();
+            } else if (s->gauge) {
+                out << "\"type\":\"gauge\",\"value\":" << s->gauge->value();
+            } else {
+                const Histogram& h = *s->histogram;
+                out << "\"type\":\"histogram\",\"count\":" << h.count()
+                    << ",\"sum_seconds\":" << nanosToSeconds(h.sumNanos())
+                    << ",\"buckets\":[";
+                for (size_t i = 0; i <= Histogram::BUCKET_COUNT; ++i) {
+                    if (i) out << ",";
+                    out << "{\"le\":";
+                    if (i < Histogram::BUCKET_COUNT) {
+                        out << nanosToSeconds(Histogram::bucketUpperNanos(i));
+                    } else {
+                        out << "\"+Inf\"";
+                    }
+                    out << ",\"count\":" << h.bucket(i) << "}";
+                }
+                out << "]";
+            }
+            out << "}";
+        }
+    }
+    out << "]}\n";
+    return out.str();
+}
+
+bool MetricsRegistry::writeSnapshot(const std::string& path, MetricsFormat fmt) const {
+    std::string data = snapshot(fmt);
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+        if (!f) {
+            return false;
+        }
+        f.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!f) {
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(path.c_str()); // rename does not overwrite on Windows
+#endif
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+// ---------------- Backend hooks ----------------
+
+CryptoMetrics CryptoMetrics::forAlgorithm(const std::string& alg_name) {
+    MetricLabels l = {{"alg", alg_name}};
+    MetricsRegistry& reg = metrics();
+
+    CryptoMetrics m;
+    m.keygen = &reg.histogram("pqbc_keygen_seconds", "Keypair generation latency", l);
+    m.sign = &reg.histogram("pqbc_sign_seconds", "Signing latency", l);
+    m.verify = &reg.histogram("pqbc_verify_seconds", "Signature verification latency", l);
+    m.verified = &reg.counter("pqbc_signatures_verified_total", "Signatures that verified", l);
+    m.failed = &reg.counter("pqbc_signature_failures_total", "Signatures that failed verification", l);
+    return m;
+}
+
+// ---------------- Exporter ----------------
+
+MetricsExporter::MetricsExporter(std::string path, MetricsFormat fmt, unsigned interval_ms)
+    : path_(std::move(path)), fmt_(fmt), interval_ms_(interval_ms)
+{
+    thread_ = std::thread(&MetricsExporter::run, this);
+}
+
+MetricsExporter::~MetricsExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    metrics().writeSnapshot(path_, fmt_);
+}
+
+void MetricsExporter::run() {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_) {
+        cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_), [this] { return stop_; });
+        if (stop_) {
+            break;
+        }
+        lock.unlock();
+        metrics().writeSnapshot(path_, fmt_);
+        lock.lock();
+    }
+}
@@ -1,4 +1,5 @@
 #include "oqs_falcon_crypto.h"
+#include "randomness.h"
 #include <stdexcept>
 
 static std::string variantToOqsNameFalcon(const std::string& v) {
@@ -11,10 +12,12 @@ OqsFalconCrypto::OqsFalconCrypto(const std::string& variant)
     : variant_(variant),
       oqs_alg_name_(variantToOqsNameFalcon(variant))
 {
+    installOqsRandomness(); // keygen/sign randomness comes from randomness.h
     sig_ = OQS_SIG_new(oqs_alg_name_.c_str());
     if (!sig_) {
         throw std::runtime_error("Failed to init OQS_SIG for " + oqs_alg_name_);
     }
+    metrics_ = CryptoMetrics::forAlgorithm(name());
 }
 
 OqsFalconCrypto::~OqsFalconCrypto() {
@@ -26,6 +29,7 @@ OqsFalconCrypto::~OqsFalconCrypto() {
 
 std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
 OqsFalconCrypto::generateKeypair() {
+    ScopedLatency timer(*metrics_.keygen);
     std::vector<uint8_t> pk(sig_->length_public_key);
     std::vector<uint8_t> sk(sig_->length_secret_key);
 
@@ -38,12 +42,22 @@ OqsFalconCrypto::generateKeypair() {
 std::vector<uint8_t>
 OqsFalconCrypto::sign(const std::vector<uint8_t>& msg,
                       const std::vector<uint8_t>& sk) {
+    return signWithKey(msg, sk.data(), sk.size());
+}
+
+std::vector<uint8_t>
+OqsFalconCrypto::signWithKey(const std::vector<uint8_t>& msg,
+                             const uint8_t* sk, size_t sk_len) {
+    ScopedLatency timer(*metrics_.sign);
+    if (sk_len != sig_->length_secret_key) {
+        throw std::runtime_error("Falcon sign: unexpected secret key size");
+    }
     std::vector<uint8_t> sig(sig_->length_signature);
     size_t sig_len = 0;
 
     if (OQS_SIG_sign(sig_, sig.data(), &sig_len,
                      msg.data(), msg.size(),
-                     sk.data()) != OQS_SUCCESS) {
+                     sk) != OQS_SUCCESS) {
         throw std::runtime_error("Falcon sign failed");
     }
     sig.resize(sig_len);
@@ -54,17 +68,30 @@ bool
 OqsFalconCrypto::verify(const std::vector<uint8_t>& msg,
                         const std::vector<uint8_t>& sig,
                         const std::vector<uint8_t>& pk) {
+    ScopedLatency timer(*metrics_.verify);
+    // liboqs reads length_public_key bytes of pk whatever its size; keys
+    // and signatures decoded from untrusted bytes can be any length.
+    if (pk.size() != sig_->length_public_key || sig.size() > sig_->length_signature) {
+        metrics_.failed->inc();
+        return false;
+    }
     auto rc = OQS_SIG_verify(sig_,
                              msg.data(), msg.size(),
                              sig.data(), sig.size(),
                              pk.data());
-    return rc == OQS_SUCCESS;
+    bool ok = rc == OQS_SUCCESS;
+    (ok ? metrics_.verified : metrics_.failed)->inc();
+    return ok;
 }
 
 std::string OqsFalconCrypto::name() const {
     return "Falcon-" + variant_;
 }
 
+SchemeId OqsFalconCrypto::schemeId() const {
+    return schemeIdFor({AlgoFamily::FALCON, variant_});
+}
+
 size_t OqsFalconCrypto::publicKeySize() const {
     return sig_->length_public_key;
 }
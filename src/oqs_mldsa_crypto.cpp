@@ -1,4 +1,5 @@
 #include "oqs_mldsa_crypto.h"
+#include "randomness.h"
 #include <stdexcept>
 
 static std::string variantToOqsName(const std::string& v) {
@@ -12,10 +13,12 @@ OqsMldsaCrypto::OqsMldsaCrypto(const std::string& variant)
     : variant_(variant),
       oqs_alg_name_(variantToOqsName(variant))
 {
+    installOqsRandomness(); // keygen/sign randomness comes from randomness.h
     sig_ = OQS_SIG_new(oqs_alg_name_.c_str());
     if (!sig_) {
         throw std::runtime_error("Failed to init OQS_SIG for " + oqs_alg_name_);
     }
+    metrics_ = CryptoMetrics::forAlgorithm(name());
 }
 
 OqsMldsaCrypto::~OqsMldsaCrypto() {
@@ -27,6 +30,7 @@ OqsMldsaCrypto::~OqsMldsaCrypto() {
 
 std::pair<std::vector<uint8_t>, std::vector<uint8_t>>
 OqsMldsaCrypto::generateKeypair() {
+    ScopedLatency timer(*metrics_.keygen);
     std::vector<uint8_t> pk(sig_->length_public_key);
     std::vector<uint8_t> sk(sig_->length_secret_key);
 
@@ -39,12 +43,22 @@ OqsMldsaCrypto::generateKeypair() {
 std::vector<uint8_t>
 OqsMldsaCrypto::sign(const std::vector<uint8_t>& msg,
                      const std::vector<uint8_t>& sk) {
+    return signWithKey(msg, sk.data(), sk.size());
+}
+
+std::vector<uint8_t>
+OqsMldsaCrypto::signWithKey(const std::vector<uint8_t>& msg,
+                            const uint8_t* sk, size_t sk_len) {
+    ScopedLatency timer(*metrics_.sign);
+    if (sk_len != sig_->length_secret_key) {
+        throw std::runtime_error("ML-DSA sign: unexpected secret key size");
+    }
     std::vector<uint8_t> sig(sig_->length_signature);
     size_t sig_len = 0;
 
     if (OQS_SIG_sign(sig_, sig.data(), &sig_len,
                      msg.data(), msg.size(),
-                     sk.data()) != OQS_SUCCESS) {
+                     sk) != OQS_SUCCESS) {
         throw std::runtime_error("ML-DSA sign failed");
     }
     sig.resize(sig_len);
@@ -55,17 +69,30 @@ bool
 OqsMldsaCrypto::verify(const std::vector<uint8_t>& msg,
                        const std::vector<uint8_t>& sig,
                        const std::vector<uint8_t>& pk) {
+    ScopedLatency timer(*metrics_.verify);
+    // liboqs reads length_public_key bytes of pk whatever its size; keys
+    // and signatures decoded from untrusted bytes can be any length.
+    if (pk.size() != sig_->length_public_key || sig.size() > sig_->length_signature) {
+        metrics_.failed->inc();
+        return false;
+    }
     auto rc = OQS_SIG_verify(sig_,
                              msg.data(), msg.size(),
                              sig.data(), sig.size(),
                              pk.data());
-    return rc == OQS_SUCCESS;
+    bool ok = rc == OQS_SUCCESS;
+    (ok ? metrics_.verified : metrics_.failed)->inc();
+    return ok;
 }
 
 std::string OqsMldsaCrypto::name() const {
     return "ML-DSA-" + variant_;
 }
 
+SchemeId OqsMldsaCrypto::schemeId() const {
+    return schemeIdFor({AlgoFamily::ML_DSA, variant_});
+}
+
 size_t OqsMldsaCrypto::publicKeySize() const {
     return sig_->length_public_key;
 }
@@ -0,0 +1,228 @@
+#include "randomness.h"
+#include "timing.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <oqs/rand.h>
+#include <oqs/sha3.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <bcrypt.h>
+#pragma comment(lib, "bcrypt")
+#elif defined(__linux__)
+#include <cerrno>
+#include <sys/random.h>
+#else
+#include <cstdio>
+#endif
+
+static const size_t BUFFER_LEN = 4096;
+static const uint64_t RESEED_BYTES = 1 << 20;
+static const char RNG_DOMAIN[] = "PQBC-RNG-v1";
+
+static std::atomic<uint8_t> g_mode{static_cast<uint8_t>(RngMode::BUFFERED)};
+static std::atomic<uint64_t> g_seed{0};
+static std::atomic<uint64_t> g_generation{1}; // bumped by setRngMode
+static std::atomic<uint64_t> g_next_stream{0}; // deterministic per-thread stream numbers
+
+static void osRandom(uint8_t* out, size_t len) {
+#if defined(_WIN32)
+    while (len > 0) {
+        ULONG n = len > 0x10000000 ? 0x10000000 : static_cast<ULONG>(len);
+        if (!BCRYPT_SUCCESS(BCryptGenRandom(nullptr, out, n, BCRYPT_USE_SYSTEM_PREFERRED_RNG))) {
+            throw std::runtime_error("randomBytes: BCryptGenRandom failed");
+        }
+        out += n;
+        len -= n;
+    }
+#elif defined(__linux__)
+    while (len > 0) {
+        ssize_t n = getrandom(out, len, 0);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("randomBytes: getrandom failed");
+        }
+        out += n;
+        len -= static_cast<size_t>(n);
+    }
+#else
+    FILE* f = std::fopen("/dev/urandom", "rb");
+    bool ok = f && std::fread(out, 1, len, f) == len;
+    if (f) {
+        std::fclose(f);
+    }
+    if (!ok) {
+        throw std::runtime_error("randomBytes: cannot read /dev/urandom");
+    }
+#endif
+}
+
+namespace {
+// One SHAKE256 stream per thread, squeezed BUFFER_LEN bytes at a time.
+struct ThreadRng {
+    OQS_SHA3_shake256_inc_ctx ctx;
+    bool live = false;
+    uint64_t generation = 0; // g_generation this stream was seeded under
+    uint64_t since_seed = 0;
+    size_t pos = BUFFER_LEN;
+    uint8_t buf[BUFFER_LEN];
+
+    ~ThreadRng() { release(); }
+
+    void release() {
+        if (live) {
+            OQS_SHA3_shake256_inc_ctx_release(&ctx);
+            live = false;
+        }
+    }
+
+    void seed(RngMode mode, uint64_t gen) {
+        uint8_t input[sizeof RNG_DOMAIN + 64];
+        size_t n = 0;
+        std::memcpy(input, RNG_DOMAIN, sizeof RNG_DOMAIN);
+        n += sizeof RNG_DOMAIN;
+        if (mode == RngMode::DETERMINISTIC) {
+            uint64_t words[2] = {g_seed.load(), g_next_stream.fetch_add(1)};
+            for (uint64_t w : words) {
+                for (int i = 0; i < 8; ++i) input[n++] = static_cast<uint8_t>(w >> (8 * i));
+            }
+        } else {
+            osRandom(input + n, 64);
+            n += 64;
+        }
+        release();
+        OQS_SHA3_shake256_inc_init(&ctx);
+        live = true;
+        OQS_SHA3_shake256_inc_absorb(&ctx, input, n);
+        OQS_SHA3_shake256_inc_finalize(&ctx);
+        std::memset(input, 0, sizeof input);
+        generation = gen;
+        since_seed = 0;
+        pos = BUFFER_LEN;
+    }
+
+    void draw(RngMode mode, uint8_t* out, size_t len) {
+        uint64_t gen = g_generation.load(std::memory_order_acquire);
+        if (generation != gen) {
+            seed(mode, gen);
+        }
+        while (len > 0) {
+            if (pos == BUFFER_LEN) {
+                if (mode == RngMode::BUFFERED && since_seed >= RESEED_BYTES) {
+                    seed(mode, gen);
+                }
+                OQS_SHA3_shake256_inc_squeeze(buf, BUFFER_LEN, &ctx);
+                since_seed += BUFFER_LEN;
+                pos = 0;
+            }
+            size_t n = BUFFER_LEN - pos < len ? BUFFER_LEN - pos : len;
+            std::memcpy(out, buf + pos, n);
+            std::memset(buf + pos, 0, n); // handed-out bytes are not kept
+            pos += n;
+            out += n;
+            len -= n;
+        }
+    }
+};
+
+thread_local ThreadRng t_rng;
+} // namespace
+
+void setRngMode(RngMode mode, uint64_t seed) {
+    g_seed.store(seed);
+    g_mode.store(static_cast<uint8_t>(mode));
+    g_next_stream.store(0);
+    g_generation.fetch_add(1, std::memory_order_release);
+}
+
+RngMode rngMode() {
+    return static_cast<RngMode>(g_mode.load(std::memory_order_relaxed));
+}
+
+uint64_t rngSeed() {
+    return g_seed.load();
+}
+
+bool setRngModeFromString(const std::string& spec) {
+    if (spec == "system") {
+        setRngMode(RngMode::SYSTEM);
+    } else if (spec == "buffered") {
+        setRngMode(RngMode::BUFFERED);
+    } else if (spec == "deterministic") {
+        setRngMode(RngMode::DETERMINISTIC, 0);
+    } else if (spec.rfind("deterministic:", 0) == 0) {
+        std::string digits = spec.substr(std::strlen("deterministic:"));
+        if (digits.empty() || digits.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        setRngMode(RngMode::DETERMINISTIC, std::stoull(digits));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string rngDescription() {
+    switch (rngMode()) {
+    case RngMode::SYSTEM:        return "system";
+    case RngMode::BUFFERED:      return "buffered";
+    case RngMode::DETERMINISTIC: return "deterministic (seed " + std::to_string(rngSeed()) + ")";
+    }
+    return "unknown";
+}
+
+void randomBytes(uint8_t* out, size_t len) {
+    RngMode mode = rngMode();
+    if (mode == RngMode::SYSTEM) {
+        osRandom(out, len);
+    } else {
+        t_rng.draw(mode, out, len);
+    }
+}
+
+// Both callbacks are called from C code, which an exception must not
+// unwind through; like liboqs' own system RNG, give up instead.
+void hawkRandomBytes(void* ctx, void* out, size_t len) {
+    (void)ctx;
+    try {
+        randomBytes(static_cast<uint8_t*>(out), len);
+    } catch (...) {
+        std::abort();
+    }
+}
+
+static void oqsRandomBytes(uint8_t* out, size_t len) {
+    try {
+        randomBytes(out, len);
+    } catch (...) {
+        std::abort();
+    }
+}
+
+void installOqsRandomness() {
+    static std::once_flag once;
+    std::call_once(once, [] { OQS_randombytes_custom_algorithm(&oqsRandomBytes); });
+}
+
+RngCost measureRngCost(size_t draw_bytes, size_t draws) {
+    std::vector<uint8_t> out(draw_bytes);
+    auto t1 = nowMicros();
+    for (size_t i = 0; i < draws; ++i) {
+        randomBytes(out.data(), out.size());
+    }
+    auto t2 = nowMicros();
+
+    RngCost c;
+    c.draw_bytes = draw_bytes;
+    if (draws > 0 && t2 > t1) {
+        c.ns_per_draw = (t2 - t1) * 1000.0 / draws;
+        c.mb_per_second = static_cast<double>(draw_bytes) * draws / (t2 - t1);
+    }
+    return c;
+}
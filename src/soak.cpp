@@ -0,0 +1,331 @@
+#include "soak.h"
+#include "blockchain.h"
+#include "crypto_factory.h"
+#include "fork_tree.h"
+#include "mem_accounting.h"
+#include "timing.h"
+#include "wallet.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+static const size_t LATENCY_RESERVOIR = 100000;
+
+double SoakReport::rssDriftPerMinute() const {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    double minutes = (samples.back().t_s - warm_t_s) / 60.0;
+    return minutes > 0 ? (static_cast<double>(rss_end_bytes) - rss_warm_bytes) / minutes : 0.0;
+}
+
+double SoakReport::rssGrowthPerTx() const {
+    uint64_t txs = committed_txs - warm_committed_txs;
+    return txs ? (static_cast<double>(rss_end_bytes) - rss_warm_bytes) / txs : 0.0;
+}
+
+// Value at quantile q of a sorted, non-empty vector.
+static uint64_t quantile(const std::vector<uint64_t>& sorted, double q) {
+    size_t i = static_cast<size_t>(q * sorted.size());
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+namespace {
+struct PendingTx {
+    Transaction tx;
+    uint64_t submit_us;
+};
+
+struct BuiltBlock {
+    uint64_t seq;
+    Block block;
+    std::vector<uint64_t> submit_us; // per tx, same order
+};
+
+// Shared state of one run. Lock order: never hold two of the mutexes.
+struct SoakState {
+    explicit SoakState(const SoakConfig& c) : cfg(c), rng(42) {
+        reservoir.reserve(LATENCY_RESERVOIR);
+    }
+
+    const SoakConfig& cfg;
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> submitted{0};
+
+    std::mutex pool_mu;
+    std::condition_variable pool_not_full, pool_not_empty;
+    std::deque<PendingTx> pool;
+
+    std::mutex blocks_mu;
+    std::condition_variable blocks_not_full, blocks_not_empty;
+    std::deque<BuiltBlock> blocks;
+
+    // Guarded by commit_mu.
+    std::mutex commit_mu;
+    std::condition_variable commit_turn;
+    uint64_t next_commit = 0;
+    uint64_t committed_txs = 0;
+    uint64_t committed_blocks = 0;
+    uint64_t rejected_blocks = 0;
+    uint64_t max_latency = 0;
+    uint64_t latencies_seen = 0;
+    std::vector<uint64_t> reservoir;  // uniform sample of all latencies
+    std::vector<uint64_t> interval;   // latencies since the last sample
+    std::mt19937_64 rng;
+
+    void recordLatency(uint64_t us) {
+        max_latency = std::max(max_latency, us);
+        interval.push_back(us);
+        ++latencies_seen;
+        if (reservoir.size() < LATENCY_RESERVOIR) {
+            reservoir.push_back(us);
+        } else {
+            uint64_t j = std::uniform_int_distribution<uint64_t>(0, latencies_seen - 1)(rng);
+            if (j < LATENCY_RESERVOIR) {
+                reservoir[j] = us;
+            }
+        }
+    }
+};
+
+void producerLoop(SoakState& s, Wallet& sender, const std::vector<uint8_t>& to) {
+    uint64_t nonce = 1;
+    size_t cap = s.cfg.mempool_capacity ? s.cfg.mempool_capacity : 4 * s.cfg.max_block_txs;
+    while (!s.stop.load(std::memory_order_relaxed)) {
+        uint64_t t0 = nowMicros();
+        Transaction tx = sender.createTransaction(to, 1, nonce++);
+
+        std::unique_lock<std::mutex> lock(s.pool_mu);
+        s.pool_not_full.wait(lock, [&] { return s.pool.size() < cap || s.stop; });
+        if (s.stop) {
+            break;
+        }
+        s.pool.push_back({std::move(tx), t0});
+        s.submitted.fetch_add(1, std::memory_order_relaxed);
+        lock.unlock();
+        s.pool_not_empty.notify_one();
+    }
+}
+
+void builderLoop(SoakState& s, Block parent) {
+    using Clock = std::chrono::steady_clock;
+    const auto interval = std::chrono::milliseconds(s.cfg.block_interval_ms);
+    const size_t queue_cap = 2 * static_cast<size_t>(s.cfg.validators);
+    uint64_t seq = 0;
+
+    std::vector<PendingTx> batch;
+    batch.reserve(s.cfg.max_block_txs);
+    auto deadline = Clock::now() + interval;
+    while (!s.stop) {
+        {
+            std::unique_lock<std::mutex> lock(s.pool_mu);
+            s.pool_not_empty.wait_until(lock, deadline, [&] { return !s.pool.empty() || s.stop; });
+            while (!s.pool.empty() && batch.size() < s.cfg.max_block_txs) {
+                batch.push_back(std::move(s.pool.front()));
+                s.pool.pop_front();
+            }
+        }
+        s.pool_not_full.notify_all();
+
+        if (batch.size() < s.cfg.max_block_txs && Clock::now() < deadline) {
+            continue;
+        }
+        deadline = Clock::now() + interval;
+        if (batch.empty()) {
+            continue; // no empty blocks
+        }
+
+        BuiltBlock out;
+        out.seq = seq++;
+        std::vector<Transaction> txs;
+        txs.reserve(batch.size());
+        out.submit_us.reserve(batch.size());
+        for (auto& p : batch) {
+            txs.push_back(std::move(p.tx));
+            out.submit_us.push_back(p.submit_us);
+        }
+        batch.clear();
+        out.block = ForkTree::createBlock(parent, txs, nowMicros());
+        parent.index = out.block.index;
+        parent.block_hash = out.block.block_hash;
+
+        std::unique_lock<std::mutex> lock(s.blocks_mu);
+        s.blocks_not_full.wait(lock, [&] { return s.blocks.size() < queue_cap || s.stop; });
+        if (s.stop) {
+            break;
+        }
+        s.blocks.push_back(std::move(out));
+        lock.unlock();
+        s.blocks_not_empty.notify_one();
+    }
+}
+
+// Signatures are checked in parallel; linkage, hash and witness are checked
+// by appendPreverifiedBlock strictly in build order (the two halves of
+// validateBlock).
+void validatorLoop(SoakState& s, Blockchain& chain) {
+    for (;;) {
+        BuiltBlock b;
+        {
+            std::unique_lock<std::mutex> lock(s.blocks_mu);
+            s.blocks_not_empty.wait(lock, [&] { return !s.blocks.empty() || s.stop; });
+            if (s.stop) {
+                return; // queued blocks are dropped; popped ones all commit
+            }
+            b = std::move(s.blocks.front());
+            s.blocks.pop_front();
+        }
+        s.blocks_not_full.notify_one();
+
+        bool sigs_ok = verifyBlockSignatures(chain.registry(), b.block);
+        size_t tx_count = b.block.transactions.size();
+
+        std::unique_lock<std::mutex> lock(s.commit_mu);
+        s.commit_turn.wait(lock, [&] { return s.next_commit == b.seq; });
+        bool ok = sigs_ok && chain.appendPreverifiedBlock(std::move(b.block));
+        uint64_t now = nowMicros();
+        if (ok) {
+            s.committed_txs += tx_count;
+            ++s.committed_blocks;
+            for (uint64_t t : b.submit_us) {
+                s.recordLatency(now - t);
+            }
+        } else {
+            ++s.rejected_blocks;
+        }
+        ++s.next_commit;
+        lock.unlock();
+        s.commit_turn.notify_all();
+    }
+}
+} // namespace
+
+SoakReport runSoak(const AlgoConfig& algo, const SoakConfig& cfg,
+                   const std::function<void(const SoakSample&)>& on_sample) {
+    if (cfg.producers == 0 || cfg.validators == 0 || cfg.max_block_txs == 0 ||
+        cfg.sample_interval_ms == 0) {
+        throw std::runtime_error("runSoak: producers, validators, max_block_txs and "
+                                 "sample_interval_ms must be > 0");
+    }
+
+    // One backend per producer, as in KeypairPool; validators share the chain's.
+    auto crypto = createCrypto(algo);
+    Blockchain chain(crypto);
+    chain.setWitnessPruneDepth(cfg.witness_prune_depth);
+    Wallet receiver(crypto);
+    receiver.generateNewKeypair();
+    std::vector<std::unique_ptr<Wallet>> senders;
+    for (unsigned i = 0; i < cfg.producers; ++i) {
+        senders.push_back(std::make_unique<Wallet>(createCrypto(algo)));
+        senders.back()->generateNewKeypair();
+    }
+
+    SoakState s(cfg);
+    SoakReport rep;
+    const uint64_t start = nowMicros();
+    const uint64_t warm_us = cfg.duration_ms * 100; // 10% of the run
+
+    std::vector<std::thread> threads;
+    for (auto& w : senders) {
+        threads.emplace_back(producerLoop, std::ref(s), std::ref(*w), std::cref(receiver.publicKey()));
+    }
+    threads.emplace_back(builderLoop, std::ref(s), chain.genesisBlock());
+    for (unsigned i = 0; i < cfg.validators; ++i) {
+        threads.emplace_back(validatorLoop, std::ref(s), std::ref(chain));
+    }
+
+    // Sample until the duration is over.
+    uint64_t last_t = start, last_txs = 0;
+    bool warm = false;
+    std::vector<uint64_t> interval;
+    for (uint64_t next = start + cfg.sample_interval_ms * 1000;; next += cfg.sample_interval_ms * 1000) {
+        uint64_t end = start + cfg.duration_ms * 1000;
+        uint64_t wake = std::min(next, end);
+        uint64_t now = nowMicros();
+        if (wake > now) {
+            std::this_thread::sleep_for(std::chrono::microseconds(wake - now));
+        }
+
+        SoakSample smp;
+        {
+            std::lock_guard<std::mutex> lock(s.commit_mu);
+            smp.committed_txs = s.committed_txs;
+            smp.blocks = s.committed_blocks;
+            interval.swap(s.interval);
+        }
+        {
+            std::lock_guard<std::mutex> lock(s.pool_mu);
+            smp.mempool = s.pool.size();
+        }
+        now = nowMicros();
+        smp.t_s = (now - start) / 1e6;
+        smp.tps = now > last_t ? (smp.committed_txs - last_txs) * 1e6 / (now - last_t) : 0.0;
+        if (!interval.empty()) {
+            std::sort(interval.begin(), interval.end());
+            smp.p50_us = quantile(interval, 0.50);
+            smp.p99_us = quantile(interval, 0.99);
+        }
+        interval.clear(); // keeps its capacity for the next swap
+        smp.rss_bytes = currentRssBytes();
+        last_t = now;
+        last_txs = smp.committed_txs;
+
+        if (!warm && now - start >= warm_us) {
+            warm = true;
+            rep.rss_warm_bytes = smp.rss_bytes;
+            rep.warm_t_s = smp.t_s;
+            rep.warm_committed_txs = smp.committed_txs;
+        }
+        rep.samples.push_back(smp);
+        if (on_sample) {
+            on_sample(smp);
+        }
+        if (now >= end) {
+            rep.elapsed_us = now - start;
+            break;
+        }
+    }
+
+    // Set stop under each queue mutex, so a thread between checking its
+    // predicate and blocking cannot miss the notify below.
+    {
+        std::lock_guard<std::mutex> pool_lock(s.pool_mu);
+        s.stop = true;
+    }
+    {
+        std::lock_guard<std::mutex> blocks_lock(s.blocks_mu);
+    }
+    s.pool_not_full.notify_all();
+    s.pool_not_empty.notify_all();
+    s.blocks_not_full.notify_all();
+    s.blocks_not_empty.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    rep.submitted_txs = s.submitted;
+    rep.committed_txs = s.committed_txs;
+    rep.blocks = s.committed_blocks;
+    rep.rejected_blocks = s.rejected_blocks;
+    rep.rss_end_bytes = rep.samples.back().rss_bytes;
+    if (!warm) {
+        rep.rss_warm_bytes = rep.samples.front().rss_bytes;
+        rep.warm_t_s = rep.samples.front().t_s;
+        rep.warm_committed_txs = rep.samples.front().committed_txs;
+    }
+    if (!s.reservoir.empty()) {
+        std::sort(s.reservoir.begin(), s.reservoir.end());
+        rep.p50_us = quantile(s.reservoir, 0.50);
+        rep.p90_us = quantile(s.reservoir, 0.90);
+        rep.p99_us = quantile(s.reservoir, 0.99);
+        rep.p999_us = quantile(s.reservoir, 0.999);
+        rep.max_us = s.max_latency;
+    }
+    return rep;
+}
@@ -0,0 +1,33 @@
+#include "thread_affinity.h"
+#include <thread>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+unsigned hardwareThreadCount() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+bool pinCurrentThreadToCpu(unsigned cpu) {
+    cpu %= hardwareThreadCount();
+#if defined(_WIN32)
+    if (cpu >= sizeof(DWORD_PTR) * 8) {
+        return false; // beyond the first processor group
+    }
+    DWORD_PTR mask = static_cast<DWORD_PTR>(1) << cpu;
+    return SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
@@ -1,6 +1,8 @@
 // src/timing.cpp
 #include "timing.h"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
 uint64_t nowMicros() {
     using namespace std::chrono;
@@ -8,3 +10,16 @@ uint64_t nowMicros() {
         steady_clock::now().time_since_epoch()
     ).count();
 }
+
+uint64_t percentileMicros(std::vector<uint64_t> samples, double p) {
+    if (samples.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * samples.size()));
+    if (rank > 0) {
+        --rank;
+    }
+    rank = std::min(rank, samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+}
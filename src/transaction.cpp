@@ -1,20 +1,112 @@
 #include "transaction.h"
 #include "block_utils.h"
+#include <cstring>
+
+static const char TX_DIGEST_DOMAIN[] = "PQBC-TX-DIGEST-v1";
+static const uint8_t TX_TAG_DIGEST_BIT = 0x80;
 
 std::vector<uint8_t> serializeTxForSigning(const Transaction& tx) {
-    std::vector<uint8_t> out;
+    // scheme tag, from_pubkey and to_pubkey (length + bytes), amount, nonce
+    std::vector<uint8_t> out(txBodySize(tx));
+    BufferSink sink(out.data(), out.size());
+    ByteWriter<BufferSink> w(sink);
+    encodeTxBody(w, tx);
 
-    // from_pubkey (length + bytes)
-    appendUint64(out, static_cast<uint64_t>(tx.from_pubkey.size()));
-    out.insert(out.end(), tx.from_pubkey.begin(), tx.from_pubkey.end());
+    countSerializedBytes(out.size());
+    return out;
+}
 
-    // to_pubkey (length + bytes)
-    appendUint64(out, static_cast<uint64_t>(tx.to_pubkey.size()));
-    out.insert(out.end(), tx.to_pubkey.begin(), tx.to_pubkey.end());
+size_t txBodySize(const Transaction& tx) {
+    return 1 + 8 + tx.from_pubkey.size() + 8 + tx.to_pubkey.size() + 8 + 8;
+}
 
-    // amount + nonce
-    appendUint64(out, tx.amount);
-    appendUint64(out, tx.nonce);
+uint8_t txSchemeTag(const Transaction& tx) {
+    uint8_t tag = static_cast<uint8_t>(tx.scheme);
+    if (tx.sig_mode == TxSigMode::DIGEST) {
+        tag |= TX_TAG_DIGEST_BIT;
+    }
+    return tag;
+}
 
-    return out;
+void setTxSchemeTag(Transaction& tx, uint8_t tag) {
+    tx.sig_mode = (tag & TX_TAG_DIGEST_BIT) ? TxSigMode::DIGEST : TxSigMode::BODY;
+    tx.scheme = static_cast<SchemeId>(tag & ~TX_TAG_DIGEST_BIT);
+}
+
+static std::vector<uint8_t> digestMessage(const TxId& id) {
+    std::vector<uint8_t> msg(TX_DIGEST_DOMAIN, TX_DIGEST_DOMAIN + sizeof(TX_DIGEST_DOMAIN) - 1);
+    msg.insert(msg.end(), id.begin(), id.end());
+    return msg;
+}
+
+static std::shared_ptr<const TxEncoding> buildEncoding(const Transaction& tx) {
+    auto enc = std::make_shared<TxEncoding>();
+    enc->body = serializeTxForSigning(tx);
+    enc->id = simpleHash32(enc->body);
+    if (tx.sig_mode == TxSigMode::DIGEST) {
+        enc->digest_msg = digestMessage(enc->id);
+    }
+    return enc;
+}
+
+// Compares 'n' bytes at body[pos] with 'p'; advances pos.
+static bool sameBytes(const std::vector<uint8_t>& body, size_t& pos, const uint8_t* p, size_t n) {
+    bool same = n == 0 || std::memcmp(body.data() + pos, p, n) == 0;
+    pos += n;
+    return same;
+}
+
+static bool sameU64(const std::vector<uint8_t>& body, size_t& pos, uint64_t v) {
+    uint8_t b[8];
+    for (int i = 0; i < 8; ++i) b[i] = static_cast<uint8_t>(v >> (8 * i));
+    return sameBytes(body, pos, b, 8);
+}
+
+const TxEncoding* cachedTxEncoding(const Transaction& tx) {
+    const TxEncoding* enc = tx.encoding.get();
+    if (!enc || enc->body.size() != txBodySize(tx)) {
+        return nullptr;
+    }
+    const std::vector<uint8_t>& body = enc->body;
+    const uint8_t tag = txSchemeTag(tx);
+    size_t pos = 0;
+    bool same = sameBytes(body, pos, &tag, 1) &&
+                sameU64(body, pos, tx.from_pubkey.size()) &&
+                sameBytes(body, pos, tx.from_pubkey.data(), tx.from_pubkey.size()) &&
+                sameU64(body, pos, tx.to_pubkey.size()) &&
+                sameBytes(body, pos, tx.to_pubkey.data(), tx.to_pubkey.size()) &&
+                sameU64(body, pos, tx.amount) &&
+                sameU64(body, pos, tx.nonce) &&
+                // the mode decides which message was signed
+                enc->digest_msg.empty() == (tx.sig_mode == TxSigMode::BODY);
+    return same ? enc : nullptr;
+}
+
+TxId computeTxId(const Transaction& tx) {
+    if (const TxEncoding* enc = cachedTxEncoding(tx)) {
+        return enc->id;
+    }
+    return encodeToHash([&](auto& w) { encodeTxBody(w, tx); });
+}
+
+void cacheTxEncoding(Transaction& tx) {
+    tx.encoding = buildEncoding(tx);
+}
+
+void clearTxEncoding(Transaction& tx) {
+    tx.encoding.reset();
+}
+
+std::shared_ptr<const TxEncoding> txEncoding(const Transaction& tx) {
+    return cachedTxEncoding(tx) ? tx.encoding : buildEncoding(tx);
+}
+
+std::vector<uint8_t> txSigningMessage(const Transaction& tx) {
+    if (tx.sig_mode == TxSigMode::DIGEST) {
+        return digestMessage(computeTxId(tx));
+    }
+    if (const TxEncoding* enc = cachedTxEncoding(tx)) {
+        return enc->body;
+    }
+    return serializeTxForSigning(tx);
 }
@@ -1,26 +1,82 @@
 #include "wallet.h"
+#include "metrics.h"
+#include <stdexcept>
 
 Wallet::Wallet(std::shared_ptr<Crypto> crypto)
     : crypto_(std::move(crypto)) {}
 
+void Wallet::setKeypair(std::vector<uint8_t> pk, std::vector<uint8_t> sk) {
+    // Expand the secret key once; every createTransaction reuses it.
+    prepared_ = crypto_->prepareSigningKey(sk);
+    pk_ = std::move(pk);
+    sk_ = std::move(sk);
+    keystore_.reset();
+    bound_ = KeystoreEntry();
+}
+
+void Wallet::bindKeystoreEntry(std::shared_ptr<const Keystore> store, size_t index) {
+    if (!store || store->scheme() != crypto_->schemeId()) {
+        throw std::runtime_error("Wallet: keystore scheme does not match wallet");
+    }
+    bound_ = store->entry(index);
+    keystore_ = std::move(store);
+    pk_ = bound_.publicKey();
+    sk_.clear();
+    prepared_.reset();
+}
+
 void Wallet::generateNewKeypair() {
     auto pair = crypto_->generateKeypair();
-    pk_ = std::move(pair.first);
-    sk_ = std::move(pair.second);
+    setKeypair(std::move(pair.first), std::move(pair.second));
+}
+
+bool Wallet::generateNewKeypair(KeypairPool& pool, bool blocking) {
+    if (pool.schemeId() != crypto_->schemeId()) {
+        throw std::runtime_error("Wallet: keypair pool scheme does not match wallet");
+    }
+
+    static Counter& pool_fallbacks =
+        metrics().counter("pqbc_wallet_keygen_fallback_total", "Wallet keygens done inline after a pool miss");
+
+    KeypairPool::Keypair pair;
+    bool from_pool = true;
+    if (blocking) {
+        pair = pool.take();
+    } else if (!pool.tryTake(pair)) {
+        pair = crypto_->generateKeypair();
+        from_pool = false;
+        pool_fallbacks.inc();
+    }
+    setKeypair(std::move(pair.first), std::move(pair.second));
+    return from_pool;
 }
 
 Transaction Wallet::createTransaction(const std::vector<uint8_t>& to_pubkey,
                                       uint64_t amount,
                                       uint64_t nonce) const {
+    static Histogram& create_latency =
+        metrics().histogram("pqbc_wallet_create_tx_seconds", "Wallet::createTransaction latency (incl. signing)");
+    ScopedLatency timer(create_latency);
+
     Transaction tx;
+    tx.scheme      = crypto_->schemeId();
+    tx.sig_mode    = sig_mode_;
     tx.from_pubkey = pk_;
     tx.to_pubkey   = to_pubkey;
     tx.amount      = amount;
     tx.nonce       = nonce;
 
-    // Sign the tx body
-    std::vector<uint8_t> msg = serializeTxForSigning(tx);
-    tx.signature = crypto_->sign(msg, sk_);
+    // Encode once to sign. Until the tx is stored in a block (which drops
+    // the cache), tx id and signature checks reuse it; block hashing and
+    // serialization always encode from the fields.
+    cacheTxEncoding(tx);
+    if (keystore_) {
+        tx.signature = crypto_->signWithKey(tx.encoding->message(), bound_.sk, bound_.sk_len);
+    } else if (prepared_) {
+        tx.signature = crypto_->signPrepared(tx.encoding->message(), *prepared_);
+    } else {
+        throw std::runtime_error("Wallet: no keypair");
+    }
 
     return tx;
 }
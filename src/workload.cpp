@@ -0,0 +1,252 @@
+#include "workload.h"
+#include "byte_codec.h"
+#include "wallet.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+static const uint32_t WORKLOAD_MAGIC   = 0x4C575150u; // "PQWL" little-endian
+static const uint32_t WORKLOAD_VERSION = 1;
+static const size_t MIN_TX_RECORD = 1 + 4 + 4 + 8 + 8 + 8; // tag, from, to, amount, nonce, sig length
+
+const char* distributionName(AccountDistribution d) {
+    switch (d) {
+    case AccountDistribution::UNIFORM: return "uniform";
+    case AccountDistribution::ZIPF:    return "zipf";
+    }
+    return "?";
+}
+
+// Draws account indices from a uniform or Zipf distribution. For Zipf the
+// popularity ranks are mapped onto accounts through a seeded permutation,
+// so the hot senders and hot receivers are different accounts.
+class AccountSampler {
+public:
+    AccountSampler(AccountDistribution dist, size_t n, double s, std::mt19937_64& rng)
+        : dist_(dist), n_(n), rank_to_account_(n)
+    {
+        std::iota(rank_to_account_.begin(), rank_to_account_.end(), 0);
+        std::shuffle(rank_to_account_.begin(), rank_to_account_.end(), rng);
+
+        if (dist_ == AccountDistribution::ZIPF) {
+            cdf_.resize(n);
+            double acc = 0.0;
+            for (size_t k = 0; k < n; ++k) {
+                acc += 1.0 / std::pow(static_cast<double>(k + 1), s);
+                cdf_[k] = acc;
+            }
+            for (auto& c : cdf_) {
+                c /= acc;
+            }
+        }
+    }
+
+    size_t next(std::mt19937_64& rng) {
+        if (dist_ == AccountDistribution::UNIFORM) {
+            return std::uniform_int_distribution<size_t>(0, n_ - 1)(rng);
+        }
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        size_t rank = static_cast<size_t>(
+            std::lower_bound(cdf_.begin(), cdf_.end(), u) - cdf_.begin());
+        return rank_to_account_[std::min(rank, n_ - 1)];
+    }
+
+private:
+    AccountDistribution dist_;
+    size_t n_;
+    std::vector<size_t> rank_to_account_;
+    std::vector<double> cdf_;
+};
+
+Workload generateWorkload(const WorkloadConfig& cfg, std::shared_ptr<Crypto> crypto) {
+    if (cfg.account_count < 2) {
+        throw std::runtime_error("generateWorkload: need at least 2 accounts");
+    }
+
+    Workload w;
+    w.config = cfg;
+    w.scheme = crypto->schemeId();
+
+    std::vector<Wallet> wallets;
+    wallets.reserve(cfg.account_count);
+    for (size_t i = 0; i < cfg.account_count; ++i) {
+        wallets.emplace_back(crypto);
+        wallets.back().generateNewKeypair();
+        w.account_pubkeys.push_back(wallets.back().publicKey());
+    }
+
+    std::mt19937_64 rng(cfg.seed);
+    AccountSampler senders(cfg.sender_dist, cfg.account_count, cfg.zipf_s, rng);
+    AccountSampler receivers(cfg.receiver_dist, cfg.account_count, cfg.zipf_s, rng);
+    std::uniform_int_distribution<uint64_t> amount_dist(1, std::max<uint64_t>(1, cfg.max_amount));
+    std::vector<uint64_t> next_nonce(cfg.account_count, 1);
+
+    w.blocks.resize(cfg.block_count);
+    for (auto& txs : w.blocks) {
+        txs.reserve(cfg.tx_per_block);
+        for (size_t i = 0; i < cfg.tx_per_block; ++i) {
+            size_t from = senders.next(rng);
+            size_t to = receivers.next(rng);
+            while (to == from) {
+                to = receivers.next(rng);
+            }
+            uint64_t amount = amount_dist(rng);
+            txs.push_back(wallets[from].createTransaction(
+                w.account_pubkeys[to], amount, next_nonce[from]++));
+        }
+    }
+
+    return w;
+}
+
+// ---------------- Binary file format ----------------
+
+void saveWorkload(const std::string& path, const Workload& w) {
+    std::map<std::vector<uint8_t>, uint32_t> index_of;
+    for (size_t i = 0; i < w.account_pubkeys.size(); ++i) {
+        index_of.emplace(w.account_pubkeys[i], static_cast<uint32_t>(i));
+    }
+    auto lookup = [&](const std::vector<uint8_t>& pk) {
+        auto it = index_of.find(pk);
+        if (it == index_of.end()) {
+            throw std::runtime_error("saveWorkload: tx references an unknown account");
+        }
+        return it->second;
+    };
+
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        throw std::runtime_error("saveWorkload: cannot open " + path);
+    }
+    FileSink sink(f);
+    ByteWriter<FileSink> out(sink);
+
+    out.u32(WORKLOAD_MAGIC);
+    out.u32(WORKLOAD_VERSION);
+
+    const WorkloadConfig& c = w.config;
+    out.u64(c.seed);
+    out.u64(c.account_count);
+    out.u64(c.block_count);
+    out.u64(c.tx_per_block);
+    out.u8(static_cast<uint8_t>(c.sender_dist));
+    out.u8(static_cast<uint8_t>(c.receiver_dist));
+    uint64_t zipf_bits = 0;
+    static_assert(sizeof(double) == sizeof(uint64_t), "double must be 64-bit");
+    std::memcpy(&zipf_bits, &c.zipf_s, sizeof zipf_bits);
+    out.u64(zipf_bits);
+    out.u64(c.max_amount);
+    out.u8(static_cast<uint8_t>(w.scheme));
+
+    out.u64(w.account_pubkeys.size());
+    for (const auto& pk : w.account_pubkeys) {
+        out.bytes(pk);
+    }
+
+    out.u64(w.blocks.size());
+    for (const auto& txs : w.blocks) {
+        out.u64(txs.size());
+        for (const auto& tx : txs) {
+            out.u8(txSchemeTag(tx));
+            out.u32(lookup(tx.from_pubkey));
+            out.u32(lookup(tx.to_pubkey));
+            out.u64(tx.amount);
+            out.u64(tx.nonce);
+            out.bytes(tx.signature);
+        }
+    }
+
+    try {
+        sink.flush();
+    } catch (const std::runtime_error&) {
+        throw std::runtime_error("saveWorkload: write failed for " + path);
+    }
+}
+
+static AccountDistribution readDistribution(ByteReader& r) {
+    uint8_t d = r.u8();
+    if (d > static_cast<uint8_t>(AccountDistribution::ZIPF)) {
+        r.fail("unknown account distribution");
+    }
+    return static_cast<AccountDistribution>(d);
+}
+
+Workload loadWorkload(const std::string& path) {
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        throw std::runtime_error("loadWorkload: cannot open " + path);
+    }
+    std::vector<uint8_t> buf((std::istreambuf_iterator<char>(f)),
+                             std::istreambuf_iterator<char>());
+
+    ByteReader r(buf, "loadWorkload");
+    if (r.u32() != WORKLOAD_MAGIC) {
+        throw std::runtime_error("loadWorkload: not a workload file: " + path);
+    }
+    if (r.u32() != WORKLOAD_VERSION) {
+        throw std::runtime_error("loadWorkload: unsupported version in " + path);
+    }
+
+    Workload w;
+    WorkloadConfig& c = w.config;
+    c.seed = r.u64();
+    c.account_count = r.u64();
+    c.block_count = r.u64();
+    c.tx_per_block = r.u64();
+    c.sender_dist = readDistribution(r);
+    c.receiver_dist = readDistribution(r);
+    uint64_t zipf_bits = r.u64();
+    std::memcpy(&c.zipf_s, &zipf_bits, sizeof zipf_bits);
+    c.max_amount = r.u64();
+    uint8_t scheme = r.u8();
+    if (scheme == 0 || scheme >= SCHEME_ID_COUNT) {
+        r.fail("unknown scheme id");
+    }
+    w.scheme = static_cast<SchemeId>(scheme);
+
+    // Counts are bounded by the bytes left (each record has a minimum
+    // size), so a corrupt count fails here instead of allocating.
+    uint64_t accounts = r.u64();
+    if (accounts > r.remaining() / 8) {
+        r.fail("bad account count");
+    }
+    w.account_pubkeys.reserve(static_cast<size_t>(accounts));
+    for (uint64_t i = 0; i < accounts; ++i) {
+        w.account_pubkeys.push_back(r.bytes());
+    }
+
+    uint64_t blocks = r.u64();
+    if (blocks > r.remaining() / 8) {
+        r.fail("bad block count");
+    }
+    w.blocks.resize(static_cast<size_t>(blocks));
+    for (auto& txs : w.blocks) {
+        uint64_t n = r.u64();
+        if (n > r.remaining() / MIN_TX_RECORD) {
+            r.fail("bad tx count");
+        }
+        txs.resize(static_cast<size_t>(n));
+        for (auto& tx : txs) {
+            setTxSchemeTag(tx, r.u8());
+            uint32_t from = r.u32();
+            uint32_t to = r.u32();
+            if (from >= accounts || to >= accounts) {
+                throw std::runtime_error("loadWorkload: bad account index in " + path);
+            }
+            tx.from_pubkey = w.account_pubkeys[from];
+            tx.to_pubkey = w.account_pubkeys[to];
+            tx.amount = r.u64();
+            tx.nonce = r.u64();
+            tx.signature = r.bytes();
+            cacheTxEncoding(tx);
+        }
+    }
+
+    return w;
+}